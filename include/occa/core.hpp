@@ -3,9 +3,12 @@
 
 #include <occa/core/base.hpp>
 #include <occa/core/device.hpp>
+#include <occa/core/graph.hpp>
 #include <occa/core/kernel.hpp>
 #include <occa/core/kernelArg.hpp>
 #include <occa/core/memory.hpp>
+#include <occa/core/hostAtomics.hpp>
+#include <occa/core/packedArgs.hpp>
 #include <occa/core/stream.hpp>
 #include <occa/core/streamTag.hpp>
 
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 
+#include <occa/core/graph.hpp>
 #include <occa/core/kernel.hpp>
 #include <occa/core/memory.hpp>
 #include <occa/core/stream.hpp>
@@ -20,6 +21,25 @@ namespace occa {
   class modeStreamTag_t; class streamTag;
   class deviceInfo;
 
+  /**
+   * @startDoc{kernelBuildInfo}
+   *
+   * Description:
+   *   Describes a single kernel passed to [[device.buildKernels]].
+   *
+   * @endDoc
+   */
+  class kernelBuildInfo {
+   public:
+    std::string filename;
+    std::string kernelName;
+    occa::json props;
+
+    kernelBuildInfo(const std::string &filename_,
+                    const std::string &kernelName_,
+                    const occa::json &props_ = occa::json());
+  };
+
   typedef std::map<std::string, kernel>   cachedKernelMap;
   typedef cachedKernelMap::iterator       cachedKernelMapIterator;
   typedef cachedKernelMap::const_iterator cCachedKernelMapIterator;
@@ -369,6 +389,94 @@ namespace occa {
      */
     void finishAll();
 
+    /**
+     * @startDoc{kernelCacheStats}
+     *
+     * Description:
+     *   Kernels built through [[device.buildKernel]] and [[device.buildKernelFromString]]
+     *   are kept in an in-process cache, so rebuilding a kernel with the same
+     *   source and properties returns a new [[kernel]] sharing the already loaded binary.
+     *   Each returned kernel has its own arguments and can be freed independently.
+     *   Kernel files are checked for changes through their size and modification time.
+     *
+     *   Only backends that can share loaded binaries, such as `Serial` and `OpenMP`, use the cache.
+     *
+     *   The cache holds up to `kernel_cache_size` kernels (set through the device properties,
+     *   defaults to 512), evicting the least recently used ones.
+     *   Setting it to 0 disables the cache.
+     *
+     * Returns:
+     *   A [[json]] object with the cache `hits`, `misses`, `size`, and `capacity`.
+     *
+     * @endDoc
+     */
+    occa::json kernelCacheStats() const;
+
+    /**
+     * @startDoc{buildStats}
+     *
+     * Description:
+     *   Statistics of the kernels built by this device, excluding ones returned
+     *   by the in-process cache (see [[device.kernelCacheStats]]).
+     *
+     *   Setting the `OCCA_BUILD_STATS` environment variable to a filename appends
+     *   the stats as a line of JSON to it when the device is freed.
+     *
+     * Returns:
+     *   A [[json]] object with
+     *   - `kernels`, `cache_hits`, and `cache_misses` counting kernels whose binary
+     *     was found in the cache or had to be built.
+     *   - Seconds spent in each stage: `preprocess_time`, `parse_time`, `transform_time`,
+     *     `compile_time`, and `load_time`, as well as the overall `total_time`.
+     *   - `binary_bytes` for the total size of the kernel binaries.
+     *   - `builds`, an array with the stats of each kernel along with its `name` and `source`.
+     *
+     *   Stages that a backend doesn't measure are left as 0.
+     *
+     * @endDoc
+     */
+    occa::json buildStats() const;
+
+    /**
+     * @startDoc{clearKernelCache}
+     *
+     * Description:
+     *   Drops all kernels from the in-process kernel cache.
+     *   Kernels still referenced elsewhere stay alive.
+     *
+     * @endDoc
+     */
+    void clearKernelCache();
+
+    /**
+     * @startDoc{memoryPoolStats}
+     *
+     * Description:
+     *   When the device is created with `memory_pool: true`, freed allocations from
+     *   [[device.malloc]] are kept in a pool and reused by later allocations of the same size class.
+     *   Single allocations can opt in or out by passing `memory_pool: true/false` as a property,
+     *   while allocations with other custom properties always bypass the pool.
+     *
+     *   Pooled bytes, including idle ones, are counted by [[device.memoryAllocated]],
+     *   so [[device.maxMemoryAllocated]] gives the pool's high-water mark.
+     *
+     * Returns:
+     *   A [[json]] object with the pool `hits`, `misses`, `bytes_in_use`, `bytes_idle`, and `idle_buffers`.
+     *
+     * @endDoc
+     */
+    occa::json memoryPoolStats() const;
+
+    /**
+     * @startDoc{trimMemoryPool}
+     *
+     * Description:
+     *   Frees all idle allocations kept in the memory pool.
+     *
+     * @endDoc
+     */
+    void trimMemoryPool();
+
     /**
      * @startDoc{hasSeparateMemorySpace}
      *
@@ -396,6 +504,9 @@ namespace occa {
      *
      *   > Note that the stream is created but not set as the active stream.
      *
+     *   On `Serial` and `OpenMP` devices, passing `async: true` creates a stream backed by
+     *   a worker thread, so kernel launches and `async` copies are queued in order.
+     *
      * Returns:
      *   Newly created [[stream]]
      *
@@ -480,6 +591,44 @@ namespace occa {
                        const streamTag &endTag);
     //  |===============================
 
+    //  |---[ Graph ]-------------------
+    /**
+     * @startDoc{beginCapture}
+     *
+     * Description:
+     *   Starts recording kernel launches and memory copies on this device into a [[graph]]
+     *   instead of running them.
+     *
+     *   Recorded copies to the host only happen when the graph is launched.
+     *
+     * @endDoc
+     */
+    void beginCapture();
+
+    /**
+     * @startDoc{endCapture}
+     *
+     * Description:
+     *   Stops recording and returns the [[graph]] with the recorded work.
+     *
+     * Returns:
+     *   The captured [[graph]].
+     *
+     * @endDoc
+     */
+    graph endCapture();
+
+    /**
+     * @startDoc{isCapturing}
+     *
+     * Description:
+     *   Check whether kernel launches and memory copies are being recorded into a [[graph]].
+     *
+     * @endDoc
+     */
+    bool isCapturing() const;
+    //  |===============================
+
     //  |---[ Kernel ]------------------
     void setupKernelInfo(const occa::json &props,
                          const hash_t &sourceHash,
@@ -488,6 +637,15 @@ namespace occa {
 
     hash_t applyDependencyHash(const hash_t &kernelHash) const;
 
+    std::string getKernelCacheKey(const std::string &realFilename,
+                                  const std::string &kernelName,
+                                  const occa::json &props) const;
+
+    occa::kernel buildUncachedKernel(const std::string &realFilename,
+                                     const std::string &kernelName,
+                                     const hash_t &kernelHash,
+                                     occa::json &allProps) const;
+
     /**
      * @startDoc{buildKernel}
      *
@@ -581,6 +739,30 @@ namespace occa {
                                        const std::string &kernelName,
                                        const occa::json &props = occa::json()) const;
 
+    /**
+     * @startDoc{buildKernels}
+     *
+     * Description:
+     *   Builds multiple kernels at once, same as calling [[device.buildKernel]] on each entry.
+     *
+     *   Source translation happens in order on the calling thread but, for backends that support it,
+     *   uncached kernels are compiled concurrently.
+     *   The number of concurrent compilations is taken from the `OCCA_BUILD_JOBS` environment variable,
+     *   defaulting to the number of hardware threads.
+     *
+     *   Duplicate entries are only built once but, like cached kernels, still return separate kernels.
+     *
+     * Arguments:
+     *   kernels:
+     *     The filename, kernel name, and [[properties|json]] of each kernel.
+     *
+     * Returns:
+     *   The compiled [[kernel]]'s, in the same order as `kernels`.
+     *
+     * @endDoc
+     */
+    std::vector<occa::kernel> buildKernels(const std::vector<kernelBuildInfo> &kernels) const;
+
     occa::kernel buildKernelFromBinary(const std::string &filename,
                                        const std::string &kernelName,
                                        const occa::json &props = occa::json()) const;
@@ -0,0 +1,155 @@
+#ifndef OCCA_CORE_GRAPH_HEADER
+#define OCCA_CORE_GRAPH_HEADER
+
+#include <iostream>
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+
+// Unfortunately we need to expose this in include
+#include <occa/utils/gc.hpp>
+
+namespace occa {
+  class modeGraph_t; class graph;
+  class modeDevice_t; class device;
+
+  /**
+   * @startDoc{graph}
+   *
+   * Description:
+   *   A [[graph]] holds the kernel launches and memory copies recorded between
+   *   [[device.beginCapture]] and [[device.endCapture]].
+   *
+   *   Launching the graph replays the recorded work in order with the recorded arguments,
+   *   skipping the argument marshalling and validation done for each kernel launch.
+   *   Memory and host pointers used by the recorded work must stay valid while the graph is used.
+   *
+   * @endDoc
+   */
+  class graph : public gc::ringEntry_t {
+    friend class occa::modeGraph_t;
+
+   private:
+    modeGraph_t *modeGraph;
+
+   public:
+    graph();
+    graph(modeGraph_t *modeGraph_);
+
+    graph(const graph &g);
+    graph& operator = (const graph &g);
+    ~graph();
+
+   private:
+    void assertInitialized() const;
+    void setModeGraph(modeGraph_t *modeGraph_);
+    void removeGraphRef();
+
+   public:
+    void dontUseRefs();
+
+    /**
+     * @startDoc{isInitialized}
+     *
+     * Description:
+     *   Check whether the [[graph]] has been intialized.
+     *
+     * Returns:
+     *   Returns `true` if the [[graph]] has been intialized
+     *
+     * @endDoc
+     */
+    bool isInitialized() const;
+
+    modeGraph_t* getModeGraph() const;
+    modeDevice_t* getModeDevice() const;
+
+    /**
+     * @startDoc{getDevice}
+     *
+     * Description:
+     *   Returns the [[device]] used to capture the [[graph]].
+     *
+     * Returns:
+     *   The [[device]] used to capture the [[graph]]
+     *
+     * @endDoc
+     */
+    occa::device getDevice() const;
+
+    /**
+     * @startDoc{mode}
+     *
+     * Description:
+     *   Returns the mode of the [[device]] used to capture the [[graph]].
+     *
+     * Returns:
+     *   The `mode` string, such as `"Serial"`, `"CUDA"`, or `"HIP"`.
+     *
+     * @endDoc
+     */
+    const std::string& mode() const;
+
+    /**
+     * @startDoc{size}
+     *
+     * Description:
+     *   Returns the number of recorded kernel launches and memory copies.
+     *
+     * @endDoc
+     */
+    int size() const;
+
+    /**
+     * @startDoc{operator_equals[0]}
+     *
+     * Description:
+     *   Compare if two graphs have the same references.
+     *
+     * Returns:
+     *   If the references are the same, this returns `true` otherwise `false`.
+     *
+     * @endDoc
+     */
+    bool operator == (const occa::graph &other) const;
+
+    /**
+     * @startDoc{operator_equals[1]}
+     *
+     * Description:
+     *   Compare if two graphs have different references.
+     *
+     * Returns:
+     *   If the references are different, this returns `true` otherwise `false`.
+     *
+     * @endDoc
+     */
+    bool operator != (const occa::graph &other) const;
+
+    /**
+     * @startDoc{launch}
+     *
+     * Description:
+     *   Replays the recorded work on the active [[stream]] of the [[device]].
+     *
+     *   Serial and OpenMP graphs run consecutive OpenMP kernels inside a single
+     *   parallel region, avoiding the fork and join of each launch.
+     *
+     * @endDoc
+     */
+    void launch() const;
+
+    /**
+     * @startDoc{free}
+     *
+     * Description:
+     *   Free the graph object.
+     *   Calling [[graph.isInitialized]] will return `false` now.
+     *
+     * @endDoc
+     */
+    void free();
+  };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef OCCA_CORE_HOSTATOMICS_HEADER
+#define OCCA_CORE_HOSTATOMICS_HEADER
+
+namespace occa {
+  //---[ Host Atomics ]-----------------
+  // Used by OpenMP kernels to lower [@atomic x = min(x, value)] and
+  //   [@atomic x = max(x, value)] without a critical section
+  namespace hostAtomics {
+    template <class TM>
+    inline bool compareExchange(TM *ptr,
+                                TM &expected,
+                                const TM &desired) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __atomic_compare_exchange(ptr, &expected, const_cast<TM*>(&desired),
+                                       true, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#else
+      bool exchanged;
+#pragma omp critical(_occa_host_atomics)
+      {
+        exchanged = (*ptr == expected);
+        if (exchanged) {
+          *ptr = desired;
+        } else {
+          expected = *ptr;
+        }
+      }
+      return exchanged;
+#endif
+    }
+
+    template <class TM>
+    inline TM load(TM *ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+      TM value;
+      __atomic_load(ptr, &value, __ATOMIC_RELAXED);
+      return value;
+#else
+      return *((volatile TM*) ptr);
+#endif
+    }
+  }
+
+  template <class TM, class valueType>
+  inline void atomicMin(TM *ptr,
+                        const valueType &value_) {
+    const TM value = (TM) value_;
+    TM current = hostAtomics::load(ptr);
+    while ((value < current)
+           && !hostAtomics::compareExchange(ptr, current, value)) {}
+  }
+
+  template <class TM, class valueType>
+  inline void atomicMax(TM *ptr,
+                        const valueType &value_) {
+    const TM value = (TM) value_;
+    TM current = hostAtomics::load(ptr);
+    while ((current < value)
+           && !hostAtomics::compareExchange(ptr, current, value)) {}
+  }
+  //====================================
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef OCCA_CORE_PACKEDARGS_HEADER
+#define OCCA_CORE_PACKEDARGS_HEADER
+
+namespace occa {
+  //---[ Packed Arguments ]-------------
+  // Used by host kernels to unpack an array of argument pointers
+  //   without going through an argc switch
+  namespace packedArgs {
+    template <int ...indices>
+    struct indexSequence {};
+
+    template <int count, int ...indices>
+    struct makeIndexSequence : makeIndexSequence<count - 1, count - 1, indices...> {};
+
+    template <int ...indices>
+    struct makeIndexSequence<0, indices...> {
+      typedef indexSequence<indices...> type;
+    };
+
+    // Pointer arguments are passed as-is
+    template <class argType>
+    struct unpack {
+      static inline argType get(void *arg) {
+        return (argType) arg;
+      }
+    };
+
+    // Non-pointer arguments are passed by reference
+    template <class argType>
+    struct unpack<argType&> {
+      static inline argType& get(void *arg) {
+        return *((argType*) arg);
+      }
+    };
+
+    template <class ...argTypes, int ...indices>
+    inline void call(void (*func)(argTypes...),
+                     void **args,
+                     indexSequence<indices...>) {
+      func(unpack<argTypes>::get(args[indices])...);
+    }
+  }
+
+  template <class ...argTypes>
+  inline void callWithPackedArgs(void (*func)(argTypes...),
+                                 void **args) {
+    packedArgs::call(
+      func,
+      args,
+      typename packedArgs::makeIndexSequence<sizeof...(argTypes)>::type()
+    );
+  }
+  //====================================
+}
+
+#endif
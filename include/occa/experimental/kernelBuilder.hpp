@@ -1,15 +1,33 @@
 #ifndef OCCA_EXPERIMENTAL_CORE_KERNELBUILDER_HEADER
 #define OCCA_EXPERIMENTAL_CORE_KERNELBUILDER_HEADER
 
+#include <map>
+#include <vector>
+
 #include <occa/core/kernel.hpp>
 #include <occa/functional/scope.hpp>
 
 namespace occa {
+  // Kernel built for a device and scope signature, with the scope index
+  //   of each kernel argument resolved on the first launch
+  class kernelLaunchPlan {
+  public:
+    occa::kernel kernel;
+    std::vector<int> argIndices;
+    strVector argNames;
+
+    bool matches(const occa::scope &scope) const;
+
+    void setArgIndices(const occa::scope &scope);
+  };
+
+  typedef std::map<hash_t, kernelLaunchPlan> hashedLaunchPlanMap;
+
   class kernelBuilder {
   private:
     std::string source;
     std::string kernelName;
-    hashedKernelMap kernelMap;
+    hashedLaunchPlanMap launchPlans;
 
   public:
     kernelBuilder(const std::string &source_,
@@ -23,6 +41,8 @@ namespace occa {
 
     occa::kernel getOrBuildKernel(const occa::scope &scope);
 
+    kernelLaunchPlan& getOrBuildLaunchPlan(const occa::scope &scope);
+
     void run();
     void run(const occa::scope &scope);
 
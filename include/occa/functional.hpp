@@ -2,7 +2,11 @@
 #define OCCA_FUNCTIONAL_HEADER
 
 #include <occa/functional/array.hpp>
+#include <occa/functional/asyncValue.hpp>
 #include <occa/functional/function.hpp>
+#include <occa/functional/hostView.hpp>
+#include <occa/functional/lazyArray.hpp>
+#include <occa/functional/ndarray.hpp>
 #include <occa/functional/range.hpp>
 #include <occa/functional/scope.hpp>
 #include <occa/functional/utils.hpp>
@@ -1,11 +1,17 @@
 #ifndef OCCA_FUNCTIONAL_ARRAY_HEADER
 #define OCCA_FUNCTIONAL_ARRAY_HEADER
 
+#include <type_traits>
+
+#include <occa/functional/hostView.hpp>
 #include <occa/functional/typelessArray.hpp>
 
 namespace occa {
   class kernelArg;
 
+  template <class T>
+  class lazyArray;
+
   template <class T>
   class array : public typelessArray {
     template <class T2>
@@ -39,6 +45,12 @@ namespace occa {
       typelessArray(other),
       memory_(other.memory_) {}
 
+    // Evaluates the fused lazy operations
+    array(const lazyArray<T> &lazyValues) :
+      typelessArray() {
+      lazyValues.evalTo(*this);
+    }
+
     array& operator = (const array<T> &other) {
       typelessArray::operator = (other);
       memory_ = other.memory_;
@@ -46,6 +58,13 @@ namespace occa {
       return *this;
     }
 
+    // Writes the fused lazy operations to this array, which can be the lazy source
+    array& operator = (const lazyArray<T> &lazyValues) {
+      lazyValues.evalTo(*this);
+
+      return *this;
+    }
+
     occa::scope getMapArrayScopeOverrides() const {
       return occa::scope({
         {"occa_array_ptr", memory_}
@@ -168,6 +187,11 @@ namespace occa {
 
     //---[ Lambda methods ]-------------
   public:
+    // Defers elementwise operations so they run as a single kernel
+    lazyArray<T> lazy() const {
+      return lazyArray<T>(*this);
+    }
+
     bool every(const occa::function<bool(const T&)> &fn) const {
       return typelessEvery(fn);
     }
@@ -292,6 +316,198 @@ namespace occa {
                occa::function<T2(const T2&, const T&, const int, const T*)> fn) const {
       return typelessReduce<T2>(type, localInit, true, fn);
     }
+
+    // Computes all reductions in a single pass over the array
+    std::vector<T> reduceMany(const std::vector<reductionType> &types) const {
+      return typelessReduceMany<T>(types, NULL);
+    }
+
+    // Reduces the mapped values without storing them
+    template <class T2>
+    T2 mapReduce(const occa::function<T2(const T&)> &mapFn,
+                 reductionType type) const {
+      return typelessMapReduce<T2>(type, mapFn);
+    }
+
+    template <class T2>
+    T2 mapReduce(const occa::function<T2(const T&, const int)> &mapFn,
+                 reductionType type) const {
+      return typelessMapReduce<T2>(type, mapFn);
+    }
+
+    template <class T2>
+    T2 mapReduce(const occa::function<T2(const T&, const int, const T*)> &mapFn,
+                 reductionType type) const {
+      return typelessMapReduce<T2>(type, mapFn);
+    }
+
+    template <class T2, class T3>
+    T2 mapReduce(const occa::function<T3(const T&)> &mapFn,
+                 reductionType type,
+                 const occa::function<T2(const T2&, const T3&)> &reduceFn) const {
+      return typelessMapReduce<T2>(type, mapFn, reduceFn);
+    }
+
+    template <class T2, class T3>
+    T2 mapReduce(const occa::function<T3(const T&, const int)> &mapFn,
+                 reductionType type,
+                 const occa::function<T2(const T2&, const T3&)> &reduceFn) const {
+      return typelessMapReduce<T2>(type, mapFn, reduceFn);
+    }
+
+    template <class T2, class T3>
+    T2 mapReduce(const occa::function<T3(const T&, const int, const T*)> &mapFn,
+                 reductionType type,
+                 const occa::function<T2(const T2&, const T3&)> &reduceFn) const {
+      return typelessMapReduce<T2>(type, mapFn, reduceFn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               const occa::function<T2(const T2&, const T&)> &fn) const {
+      return typelessReduceAsync<T2>(type, T2(), false, fn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return typelessReduceAsync<T2>(type, T2(), false, fn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               occa::function<T2(const T2&, const T&, const int, const T*)> fn) const {
+      return typelessReduceAsync<T2>(type, T2(), false, fn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               const T2 &localInit,
+                               const occa::function<T2(const T2&, const T&)> &fn) const {
+      return typelessReduceAsync<T2>(type, localInit, true, fn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               const T2 &localInit,
+                               const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return typelessReduceAsync<T2>(type, localInit, true, fn);
+    }
+
+    template <class T2>
+    asyncValue<T2> reduceAsync(reductionType type,
+                               const T2 &localInit,
+                               occa::function<T2(const T2&, const T&, const int, const T*)> fn) const {
+      return typelessReduceAsync<T2>(type, localInit, true, fn);
+    }
+
+    array inclusiveScan(reductionType type = reductionType::sum) const {
+      return typelessScan<T>(type, false, T());
+    }
+
+    array exclusiveScan(reductionType type = reductionType::sum,
+                        const T &initialValue = T()) const {
+      return typelessScan<T>(type, true, initialValue);
+    }
+
+    array filter(const occa::function<bool(const T&)> &fn) const {
+      return typelessFilter<T>(fn);
+    }
+
+    array filter(const occa::function<bool(const T&, const int)> &fn) const {
+      return typelessFilter<T>(fn);
+    }
+
+    array filter(const occa::function<bool(const T&, const int, const T*)> &fn) const {
+      return typelessFilter<T>(fn);
+    }
+
+    // Returns the values where fn is true followed by the rest, keeping their relative order
+    std::pair<array, array> partition(const occa::function<bool(const T&)> &fn) const {
+      return typelessPartitionArrays(fn);
+    }
+
+    std::pair<array, array> partition(const occa::function<bool(const T&, const int)> &fn) const {
+      return typelessPartitionArrays(fn);
+    }
+
+    std::pair<array, array> partition(const occa::function<bool(const T&, const int, const T*)> &fn) const {
+      return typelessPartitionArrays(fn);
+    }
+
+    // Radix sort for arithmetic types
+    array sort() const {
+      occa::memory values;
+      return radixSorted(values);
+    }
+
+    // Stable merge sort ordered by lessThan
+    array sort(const occa::function<bool(const T&, const T&)> &lessThan) const {
+      occa::memory sortedMemory = memory_.clone();
+      typelessMergeSort<T>(sortedMemory, lessThan);
+      return array(sortedMemory);
+    }
+
+    // Sorts the keys in this array and reorders values to match
+    template <class V>
+    std::pair<array, array<V>> sortByKey(const array<V> &values) const {
+      OCCA_ERROR("Keys and values must have the same length",
+                 values.length() == length());
+
+      occa::memory sortedValues = values.memory().clone();
+      array sortedKeys = radixSorted(sortedValues);
+
+      return std::make_pair(sortedKeys, array<V>(sortedValues));
+    }
+
+    // Sorts each [segmentOffsets[i], segmentOffsets[i + 1]) range independently
+    //   where segmentOffsets starts at 0 and ends at length()
+    array segmentedSort(const array<int> &segmentOffsets) const {
+      assertRadixSortable();
+      OCCA_ERROR("Segment offsets must include the start and end offsets",
+                 segmentOffsets.length() >= 2);
+
+      occa::memory sortedMemory = memory_.clone();
+      typelessSegmentedRadixSort(sortedMemory,
+                                 segmentOffsets.memory(),
+                                 (int) segmentOffsets.length() - 1,
+                                 sizeof(T),
+                                 std::is_floating_point<T>::value,
+                                 std::is_signed<T>::value);
+
+      return array(sortedMemory);
+    }
+
+  private:
+    void assertRadixSortable() const {
+      OCCA_ERROR("Sorting without a comparator requires an arithmetic type",
+                 std::is_arithmetic<T>::value);
+    }
+
+    array radixSorted(occa::memory &values) const {
+      assertRadixSortable();
+
+      occa::memory sortedMemory = memory_.clone();
+      typelessRadixSort(sortedMemory,
+                        values,
+                        sizeof(T),
+                        std::is_floating_point<T>::value,
+                        std::is_signed<T>::value);
+
+      return array(sortedMemory);
+    }
+
+    std::pair<array, array> typelessPartitionArrays(const baseFunction &fn) const {
+      int trueCount = 0;
+      array output(typelessPartition<T>(fn, trueCount));
+
+      return std::make_pair(
+        output.slice(0, trueCount),
+        output.slice(trueCount)
+      );
+    }
+
+  public:
     //==================================
 
     //---[ Utility methods ]------------
@@ -311,6 +527,16 @@ namespace occa {
       return value;
     }
 
+    // Maps [offset, offset + count) to the host with a single transfer
+    occa::hostView<T> hostView(const dim_t offset = 0,
+                               const dim_t count = -1,
+                               const int access = hostAccess::readWrite) const {
+      return occa::hostView<T>(
+        slice(offset, count).memory_,
+        access
+      );
+    }
+
     array slice(const dim_t offset,
                 const dim_t count = -1) const {
       return array(
@@ -0,0 +1,47 @@
+#ifndef OCCA_FUNCTIONAL_ASYNCVALUE_HEADER
+#define OCCA_FUNCTIONAL_ASYNCVALUE_HEADER
+
+#include <occa/core/memory.hpp>
+
+namespace occa {
+  // Handle to a single value computed on the device, such as the result of array::reduceAsync
+  // The value is only copied back to the host in get(), allowing multiple
+  //   device operations to be queued before synchronizing
+  template <class T>
+  class asyncValue {
+  private:
+    occa::memory memory_;
+    mutable bool isReady;
+    mutable T value;
+
+  public:
+    asyncValue() :
+      isReady(false),
+      value() {}
+
+    asyncValue(occa::memory mem) :
+      memory_(mem),
+      isReady(false),
+      value() {}
+
+    bool isInitialized() const {
+      return memory_.isInitialized();
+    }
+
+    // Can be passed to kernels without synchronizing
+    occa::memory memory() const {
+      return memory_;
+    }
+
+    // Waits for the value and caches it
+    const T& get() const {
+      if (!isReady) {
+        memory_.copyTo(&value, sizeof(T));
+        isReady = true;
+      }
+      return value;
+    }
+  };
+}
+
+#endif
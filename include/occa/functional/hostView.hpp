@@ -0,0 +1,152 @@
+#ifndef OCCA_FUNCTIONAL_HOSTVIEW_HEADER
+#define OCCA_FUNCTIONAL_HOSTVIEW_HEADER
+
+#include <occa/core/device.hpp>
+#include <occa/core/memory.hpp>
+#include <occa/functional/types.hpp>
+
+namespace occa {
+  // Host access to a range of device memory, such as from array::hostView
+  // The range is copied to the host once when created (if readable) and copied
+  //   back once when released (if writable)
+  // Devices sharing the host memory space alias the device memory directly
+  template <class T>
+  class hostView {
+  private:
+    occa::memory memory_;
+    T *ptr_;
+    udim_t size_;
+    int access_;
+    bool isAlias;
+
+  public:
+    hostView() :
+      ptr_(NULL),
+      size_(0),
+      access_(0),
+      isAlias(false) {}
+
+    hostView(occa::memory mem,
+             const int access = hostAccess::readWrite) :
+      memory_(mem),
+      ptr_(NULL),
+      size_(mem.length<T>()),
+      access_(access),
+      isAlias(false) {
+
+      if (!size_) {
+        return;
+      }
+
+      occa::device device = memory_.getDevice();
+      // Pending kernels can still be using the memory
+      device.finish();
+
+      if (!device.hasSeparateMemorySpace()) {
+        ptr_ = memory_.ptr<T>();
+        isAlias = true;
+        return;
+      }
+
+      ptr_ = new T[size_];
+      if (access_ & hostAccess::read) {
+        memory_.copyTo(ptr_, size_ * sizeof(T));
+      }
+    }
+
+    hostView(hostView &&other) :
+      memory_(other.memory_),
+      ptr_(other.ptr_),
+      size_(other.size_),
+      access_(other.access_),
+      isAlias(other.isAlias) {
+      other.detach();
+    }
+
+    hostView& operator = (hostView &&other) {
+      if (this != &other) {
+        release();
+        memory_ = other.memory_;
+        ptr_ = other.ptr_;
+        size_ = other.size_;
+        access_ = other.access_;
+        isAlias = other.isAlias;
+        other.detach();
+      }
+      return *this;
+    }
+
+    hostView(const hostView &other) = delete;
+    hostView& operator = (const hostView &other) = delete;
+
+    ~hostView() {
+      release();
+    }
+
+    // Writes back the host values if needed and detaches the view
+    void release() {
+      if (ptr_ && !isAlias) {
+        if (access_ & hostAccess::write) {
+          memory_.copyFrom(ptr_, size_ * sizeof(T));
+        }
+        delete [] ptr_;
+      }
+      detach();
+    }
+
+    bool isInitialized() const {
+      return ptr_ != NULL;
+    }
+
+    // Returns true if the view points directly to the device memory
+    bool isZeroCopy() const {
+      return isAlias;
+    }
+
+    udim_t length() const {
+      return size_;
+    }
+
+    T* data() {
+      return ptr_;
+    }
+
+    const T* data() const {
+      return ptr_;
+    }
+
+    T* begin() {
+      return ptr_;
+    }
+
+    const T* begin() const {
+      return ptr_;
+    }
+
+    T* end() {
+      return ptr_ + size_;
+    }
+
+    const T* end() const {
+      return ptr_ + size_;
+    }
+
+    T& operator [] (const dim_t index) {
+      return ptr_[index];
+    }
+
+    const T& operator [] (const dim_t index) const {
+      return ptr_[index];
+    }
+
+  private:
+    void detach() {
+      memory_ = occa::memory();
+      ptr_ = NULL;
+      size_ = 0;
+      isAlias = false;
+    }
+  };
+}
+
+#endif
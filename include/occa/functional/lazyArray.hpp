@@ -0,0 +1,346 @@
+#ifndef OCCA_FUNCTIONAL_LAZYARRAY_HEADER
+#define OCCA_FUNCTIONAL_LAZYARRAY_HEADER
+
+#include <vector>
+
+#include <occa/functional/array.hpp>
+
+namespace occa {
+  // Elementwise function applied to the output of the previous stage
+  class lazyArrayStage {
+  public:
+    hash_t functionHash;
+    occa::scope scope;
+    int argumentCount;
+
+    lazyArrayStage(const baseFunction &fn) :
+      functionHash(fn.hash()),
+      scope(fn.scope),
+      argumentCount(fn.argumentCount()) {}
+  };
+
+  // Deferred chain of elementwise operations on an array
+  // The chain is fused into a single kernel when it's evaluated, assigned to an
+  //   array or reduced, without storing the intermediate values
+  template <class T>
+  class lazyArray : public typelessArray {
+    template <class T2>
+    friend class array;
+
+    template <class T2>
+    friend class lazyArray;
+
+  private:
+    // Values read by the first stage
+    occa::memory source_;
+    std::vector<lazyArrayStage> stages;
+
+    lazyArray(const typelessArray &other,
+              occa::memory source__,
+              const std::vector<lazyArrayStage> &stages_) :
+      typelessArray(other),
+      source_(source__),
+      stages(stages_) {}
+
+    occa::scope getMapArrayScopeOverrides() const {
+      return occa::scope({
+        {"occa_array_ptr", source_}
+      }, {
+        {"defines/OCCA_ARRAY_FUNCTION_CALL(INDEX)",
+         "OCCA_ARRAY_FUNCTION(occa_array_ptr[INDEX], INDEX, occa_array_ptr)"}
+      });
+    }
+
+    occa::scope getReduceArrayScopeOverrides() const {
+      return occa::scope({
+        {"occa_array_ptr", source_}
+      }, {
+        {"defines/OCCA_ARRAY_FUNCTION_CALL(ACC, INDEX)",
+         "OCCA_ARRAY_FUNCTION(ACC, occa_array_ptr[INDEX], INDEX, occa_array_ptr)"}
+      });
+    }
+
+    std::string reductionInitialValue() const {
+      return buildStagesCall("occa_array_ptr[0]", "0");
+    }
+
+    static std::string getStageFunctionName(const int stageIndex) {
+      return "occa_lazy_function_" + std::to_string(stageIndex);
+    }
+
+    // Captured arguments are renamed since stages can capture the same names
+    static std::string getStageArgName(const int stageIndex,
+                                       const std::string &argName) {
+      return "occa_lazy_" + std::to_string(stageIndex) + "_" + argName;
+    }
+
+    // Returns the nested stage calls on [value] at [index]
+    std::string buildStagesCall(const std::string &value,
+                                const std::string &index) const {
+      std::string call = value;
+
+      const int stageCount = (int) stages.size();
+      for (int i = 0; i < stageCount; ++i) {
+        const lazyArrayStage &stage = stages[i];
+
+        std::string stageCall = getStageFunctionName(i) + "(" + call;
+        if (stage.argumentCount > 1) {
+          stageCall += ", " + index;
+        }
+        for (const scopeKernelArg &arg : stage.scope.getArgs()) {
+          stageCall += ", " + getStageArgName(i, arg.name);
+        }
+        stageCall += ")";
+
+        call = stageCall;
+      }
+
+      return "(" + call + ")";
+    }
+
+    // Scope with the stage functions and their captured arguments
+    occa::scope getStagesScope() const {
+      occa::scope scope;
+      scope.device = device_;
+
+      const int stageCount = (int) stages.size();
+      for (int i = 0; i < stageCount; ++i) {
+        const lazyArrayStage &stage = stages[i];
+
+        for (scopeKernelArg arg : stage.scope.getArgs()) {
+          arg.name = getStageArgName(i, arg.name);
+          scope.add(arg);
+        }
+        scope.addProps(stage.scope.getProps());
+        scope.setProp("functions/" + getStageFunctionName(i), stage.functionHash);
+      }
+
+      return scope;
+    }
+
+    // OCCA_FUNCTION sources would use T, which kernels define as the source array type,
+    //   so built-in stages use the stage type name instead
+    static std::string getTypeName() {
+      return dtype::get<T>().name();
+    }
+
+    static std::string buildValueFunctionSource(const std::string &body) {
+      return (
+        "[=](const " + getTypeName() + " &value) -> " + getTypeName() + " {"
+        + body
+        + "}"
+      );
+    }
+
+    static std::string buildAccFunctionSource(const std::string &body) {
+      return (
+        "[=](const " + getTypeName() + " &acc, const " + getTypeName() + " &value) -> " + getTypeName() + " {"
+        + body
+        + "}"
+      );
+    }
+
+    template <class T2>
+    lazyArray<T2> addStage(const baseFunction &fn) const {
+      std::vector<lazyArrayStage> nextStages = stages;
+      nextStages.push_back(lazyArrayStage(fn));
+
+      return lazyArray<T2>(*this, source_, nextStages);
+    }
+
+    template <class T2>
+    T2 typelessLazyReduce(reductionType type,
+                          const T2 &localInit,
+                          const bool useLocalInit,
+                          const baseFunction &fn) const {
+      return typelessMapReduce<T2>(type, localInit, useLocalInit,
+                                   buildStagesCall("VALUE", "INDEX"),
+                                   reductionInitialValue(),
+                                   getStagesScope(),
+                                   fn);
+    }
+
+  public:
+    explicit lazyArray(const array<T> &source) :
+      typelessArray(source),
+      source_(source.memory()) {}
+
+    lazyArray(const lazyArray<T> &other) :
+      typelessArray(other),
+      source_(other.source_),
+      stages(other.stages) {}
+
+    lazyArray& operator = (const lazyArray<T> &other) {
+      typelessArray::operator = (other);
+      source_ = other.source_;
+      stages = other.stages;
+
+      return *this;
+    }
+
+    udim_t length() const {
+      return source_.length();
+    }
+
+    int stageCount() const {
+      return (int) stages.size();
+    }
+
+    //---[ Lazy methods ]---------------
+    template <class T2>
+    lazyArray<T2> map(const occa::function<T2(const T&)> &fn) const {
+      return addStage<T2>(fn);
+    }
+
+    template <class T2>
+    lazyArray<T2> map(const occa::function<T2(const T&, const int)> &fn) const {
+      return addStage<T2>(fn);
+    }
+
+    lazyArray clamp(const T minValue,
+                    const T maxValue) const {
+      occa::scope fnScope({
+        {"minValue", minValue},
+        {"maxValue", maxValue},
+      });
+
+      return map<T>(
+        occa::function<T(const T&)>(
+          fnScope,
+          [=](const T &value) -> T {
+            const T valueWithMaxClamp = value > maxValue ? maxValue : value;
+            return valueWithMaxClamp < minValue ? minValue : valueWithMaxClamp;
+          },
+          buildValueFunctionSource(
+            "const " + getTypeName() + " valueWithMaxClamp = value > maxValue ? maxValue : value;"
+            "return valueWithMaxClamp < minValue ? minValue : valueWithMaxClamp;"
+          ).c_str()
+        )
+      );
+    }
+
+    lazyArray clampMin(const T minValue) const {
+      occa::scope fnScope({
+        {"minValue", minValue},
+      });
+
+      return map<T>(
+        occa::function<T(const T&)>(
+          fnScope,
+          [=](const T &value) -> T {
+            return value < minValue ? minValue : value;
+          },
+          buildValueFunctionSource(
+            "return value < minValue ? minValue : value;"
+          ).c_str()
+        )
+      );
+    }
+
+    lazyArray clampMax(const T maxValue) const {
+      occa::scope fnScope({
+        {"maxValue", maxValue},
+      });
+
+      return map<T>(
+        occa::function<T(const T&)>(
+          fnScope,
+          [=](const T &value) -> T {
+            return value > maxValue ? maxValue : value;
+          },
+          buildValueFunctionSource(
+            "return value > maxValue ? maxValue : value;"
+          ).c_str()
+        )
+      );
+    }
+    //==================================
+
+    //---[ Evaluation methods ]---------
+    array<T> eval() const {
+      array<T> output(device_, length());
+      evalTo(output);
+      return output;
+    }
+
+    // Elementwise stages only read their own index, so [output] can be the source array
+    void evalTo(array<T> &output) const {
+      if (output.isInitialized()) {
+        output.resize(length());
+      } else {
+        output.resize(device_, length());
+      }
+      if (!length()) {
+        return;
+      }
+
+      occa::scope scope = getMapArrayScope(
+        buildStagesCall("VALUE", "INDEX"),
+        getStagesScope()
+      );
+      occa::memory outputMemory = output.memory();
+      scope.add("occa_array_output", outputMemory);
+
+      runMapTo(scope);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return typelessLazyReduce<T2>(type, T2(), false, fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return typelessLazyReduce<T2>(type, T2(), false, fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const T2 &localInit,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return typelessLazyReduce<T2>(type, localInit, true, fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const T2 &localInit,
+              const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return typelessLazyReduce<T2>(type, localInit, true, fn);
+    }
+
+    T max() const {
+      return reduce<T>(
+        reductionType::max,
+        occa::function<T(const T&, const T&)>(
+          occa::scope(),
+          [=](const T &currentMax, const T &value) -> T {
+            return currentMax > value ? currentMax : value;
+          },
+          buildAccFunctionSource(
+            "return acc > value ? acc : value;"
+          ).c_str()
+        )
+      );
+    }
+
+    T min() const {
+      return reduce<T>(
+        reductionType::min,
+        occa::function<T(const T&, const T&)>(
+          occa::scope(),
+          [=](const T &currentMin, const T &value) -> T {
+            return currentMin < value ? currentMin : value;
+          },
+          buildAccFunctionSource(
+            "return acc < value ? acc : value;"
+          ).c_str()
+        )
+      );
+    }
+    //==================================
+  };
+}
+
+#endif
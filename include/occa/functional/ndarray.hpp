@@ -0,0 +1,331 @@
+#ifndef OCCA_FUNCTIONAL_NDARRAY_HEADER
+#define OCCA_FUNCTIONAL_NDARRAY_HEADER
+
+#include <vector>
+
+#include <occa/functional/array.hpp>
+
+namespace occa {
+  typedef std::vector<dim_t> dimVector;
+
+  enum class ndarrayLayout {
+    rowMajor,
+    columnMajor
+  };
+
+  class typelessNdarray {
+  protected:
+    occa::device device_;
+    dtype_t dtype_;
+
+    // Views share the full allocation and only change the offset, shape and strides
+    occa::memory memory_;
+    dim_t offset_;
+    dimVector shape_;
+    dimVector strides_;
+
+  public:
+    typelessNdarray();
+
+    typelessNdarray(const typelessNdarray &other);
+
+    typelessNdarray& operator = (const typelessNdarray &other);
+
+  protected:
+    void setupTypelessNdarray(occa::device device__,
+                              const dtype_t &dtype__,
+                              const dimVector &shape,
+                              const ndarrayLayout layout,
+                              const int alignment);
+
+    void setupTypelessNdarray(occa::memory mem,
+                              const dimVector &shape,
+                              const ndarrayLayout layout,
+                              const int alignment);
+
+    void typelessSlice(const int dim,
+                       const dim_t start,
+                       const dim_t count,
+                       const dim_t step);
+
+    void typelessTranspose(const int dim1,
+                           const int dim2);
+
+    void assertSameShape(const typelessNdarray &other) const;
+
+    // Dimensions ordered from the largest to the smallest stride
+    intVector getLoopOrder() const;
+
+    // Writes OCCA_NDARRAY_FUNCTION(VALUE, INDEX) of each value to [output], where INDEX
+    //   is the row-major index and [functionScope] holds the functions and arguments it uses
+    void typelessMapTo(const typelessNdarray &output,
+                       const std::string &functionCall,
+                       const occa::scope &functionScope) const;
+
+  public:
+    // Strides for a new allocation, padding the leading dimension to a multiple of [alignment] entries
+    static dimVector getStrides(const dimVector &shape,
+                                const ndarrayLayout layout,
+                                const int alignment = 1);
+
+    occa::device getDevice() const;
+
+    occa::dtype_t dtype() const;
+
+    int dims() const;
+
+    dim_t shape(const int dim) const;
+
+    const dimVector& shape() const;
+
+    dim_t stride(const int dim) const;
+
+    const dimVector& strides() const;
+
+    dim_t offset() const;
+
+    udim_t size() const;
+
+    // Entries between the first and last values, including padding and skipped entries
+    udim_t span() const;
+
+    bool isContiguous() const;
+
+    bool isRowMajor() const;
+
+    // Memory starting at the first value
+    occa::memory dataMemory() const;
+
+    operator kernelArg() const;
+
+    // Returns the @dim and @dimOrder attributes to index the dataMemory() with (i0, i1, ...)
+    // Only available for layouts where each stride is a multiple of the next smaller one
+    std::string dimAttributes() const;
+  };
+
+  template <class T, int N>
+  class ndarray : public typelessNdarray {
+    static_assert(N > 0, "ndarray needs at least one dimension");
+
+    template <class T2, int N2>
+    friend class ndarray;
+
+  public:
+    ndarray() :
+      typelessNdarray() {}
+
+    ndarray(const dimVector &shape,
+            const ndarrayLayout layout = ndarrayLayout::rowMajor,
+            const int alignment = 1) :
+      typelessNdarray() {
+      assertDims(shape);
+      setupTypelessNdarray(occa::getDevice(), dtype::get<T>(), shape, layout, alignment);
+    }
+
+    ndarray(occa::device device,
+            const dimVector &shape,
+            const ndarrayLayout layout = ndarrayLayout::rowMajor,
+            const int alignment = 1) :
+      typelessNdarray() {
+      assertDims(shape);
+      setupTypelessNdarray(device, dtype::get<T>(), shape, layout, alignment);
+    }
+
+    ndarray(occa::memory mem,
+            const dimVector &shape,
+            const ndarrayLayout layout = ndarrayLayout::rowMajor,
+            const int alignment = 1) :
+      typelessNdarray() {
+      assertDims(shape);
+      mem.setDtype(dtype::get<T>());
+      setupTypelessNdarray(mem, shape, layout, alignment);
+    }
+
+    ndarray(const ndarray<T, N> &other) :
+      typelessNdarray(other) {}
+
+    ndarray& operator = (const ndarray<T, N> &other) {
+      typelessNdarray::operator = (other);
+      return *this;
+    }
+
+    //---[ View methods ]---------------
+    // Values [start, start + (count * step)) of [dim] without copying them
+    ndarray slice(const int dim,
+                  const dim_t start,
+                  const dim_t count = -1,
+                  const dim_t step = 1) const {
+      ndarray view = *this;
+      view.typelessSlice(dim, start, count, step);
+      return view;
+    }
+
+    ndarray transpose(const int dim1,
+                      const int dim2) const {
+      ndarray view = *this;
+      view.typelessTranspose(dim1, dim2);
+      return view;
+    }
+
+    // Reverses the dimensions
+    ndarray transpose() const {
+      ndarray view = *this;
+      for (int dim = 0; dim < (N / 2); ++dim) {
+        view.typelessTranspose(dim, N - dim - 1);
+      }
+      return view;
+    }
+    //==================================
+
+    //---[ Memory methods ]-------------
+    void copyFrom(const ndarray<T, N> &other) {
+      assertSameShape(other);
+      if (size()) {
+        other.typelessMapTo(*this, "(VALUE)", occa::scope());
+      }
+    }
+
+    // [src] holds the values in row-major order
+    void copyFrom(const T *src) {
+      if (!size()) {
+        return;
+      }
+      if (isRowMajor()) {
+        dataMemory().copyFrom(src, size() * sizeof(T));
+        return;
+      }
+      ndarray<T, N> rowMajorValues(device_, shape_);
+      rowMajorValues.copyFrom(src);
+      copyFrom(rowMajorValues);
+    }
+
+    // Copies the values to [dest] in row-major order
+    void copyTo(T *dest) const {
+      if (!size()) {
+        return;
+      }
+      if (isRowMajor()) {
+        dataMemory().copyTo(dest, size() * sizeof(T));
+        return;
+      }
+      ndarray<T, N> rowMajorValues(device_, shape_);
+      rowMajorValues.copyFrom(*this);
+      rowMajorValues.copyTo(dest);
+    }
+
+    ndarray clone() const {
+      ndarray<T, N> values(device_, shape_);
+      values.copyFrom(*this);
+      return values;
+    }
+
+    // Row-major copy of the values
+    array<T> toArray() const {
+      if (!size()) {
+        return array<T>(device_, 0);
+      }
+      return array<T>(clone().dataMemory());
+    }
+    //==================================
+
+    //---[ Lambda methods ]-------------
+    template <class T2>
+    ndarray<T2, N> map(const occa::function<T2(const T&)> &fn) const {
+      ndarray<T2, N> output(device_, shape_);
+      mapTo(output, fn);
+      return output;
+    }
+
+    // The index argument is the row-major index of the value
+    template <class T2>
+    ndarray<T2, N> map(const occa::function<T2(const T&, const int)> &fn) const {
+      ndarray<T2, N> output(device_, shape_);
+      mapTo(output, fn);
+      return output;
+    }
+
+    template <class T2>
+    ndarray<T2, N>& mapTo(ndarray<T2, N> &output,
+                          const occa::function<T2(const T&)> &fn) const {
+      typelessMapFunctionTo(output, fn);
+      return output;
+    }
+
+    template <class T2>
+    ndarray<T2, N>& mapTo(ndarray<T2, N> &output,
+                          const occa::function<T2(const T&, const int)> &fn) const {
+      typelessMapFunctionTo(output, fn);
+      return output;
+    }
+
+    // Reductions on views with gaps copy the values first
+    template <class T2>
+    T2 reduce(reductionType type,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return getContiguousArray().reduce(type, fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const T2 &localInit,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return getContiguousArray().reduce(type, localInit, fn);
+    }
+
+    T max() const {
+      return getContiguousArray().max();
+    }
+
+    T min() const {
+      return getContiguousArray().min();
+    }
+
+    ndarray& fill(const T &fillValue) {
+      occa::scope fnScope({
+        {"fillValue", fillValue}
+      });
+
+      return mapTo<T>(
+        *this,
+        OCCA_FUNCTION(fnScope, [=](const T &value) -> T {
+          return fillValue;
+        })
+      );
+    }
+    //==================================
+
+  private:
+    static void assertDims(const dimVector &shape) {
+      OCCA_ERROR("Expected " << N << " dimensions",
+                 (int) shape.size() == N);
+    }
+
+    void typelessMapFunctionTo(typelessNdarray &output,
+                               const baseFunction &fn) const {
+      assertSameShape(output);
+      if (!size()) {
+        return;
+      }
+
+      strVector arguments = {"VALUE", "INDEX"};
+      arguments.resize(fn.argumentCount());
+
+      occa::scope functionScope = fn.scope;
+      functionScope.setProp("functions/occa_ndarray_function", fn);
+
+      typelessMapTo(output,
+                    fn.buildFunctionCall("occa_ndarray_function", arguments),
+                    functionScope);
+    }
+
+    // The values in any order, for order-independent operations
+    array<T> getContiguousArray() const {
+      if (isContiguous() && size()) {
+        return array<T>(dataMemory());
+      }
+      return toArray();
+    }
+  };
+}
+
+#endif
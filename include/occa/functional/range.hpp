@@ -80,6 +80,19 @@ namespace occa {
               const occa::function<T(const T&, const int)> &fn) const {
       return typelessReduce<T>(type, localInit, true, fn);
     }
+
+    template <class T>
+    asyncValue<T> reduceAsync(reductionType type,
+                              const occa::function<T(const T&, const int)> &fn) const {
+      return typelessReduceAsync<T>(type, T(), false, fn);
+    }
+
+    template <class T>
+    asyncValue<T> reduceAsync(reductionType type,
+                              const T &localInit,
+                              const occa::function<T(const T&, const int)> &fn) const {
+      return typelessReduceAsync<T>(type, localInit, true, fn);
+    }
     //==================================
 
     //---[ Utility methods ]------------
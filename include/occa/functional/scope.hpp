@@ -45,10 +45,14 @@ namespace occa {
   }
 
   class scope {
-  public:
+  private:
+    // Only edited through the methods below so the memoized hash stays valid
     occa::json props;
-    occa::device device;
     scopeKernelArgVector args;
+    mutable hash_t hash_;
+
+  public:
+    occa::device device;
 
     scope();
 
@@ -61,6 +65,7 @@ namespace occa {
 
     inline void add(scopeKernelArg arg) {
       args.push_back(arg);
+      hash_.clear();
 
       occa::device argDevice = arg.getDevice();
       if (!argDevice.isInitialized()) {
@@ -100,6 +105,19 @@ namespace occa {
       add({name, value});
     }
 
+    const occa::json& getProps() const;
+
+    template <class T>
+    void setProp(const std::string &prop,
+                 const T &value) {
+      props[prop] = value;
+      hash_.clear();
+    }
+
+    void addProps(const occa::json &props_);
+
+    const scopeKernelArgVector& getArgs() const;
+
     scope operator + (const scope &other) const;
     scope& operator += (const scope &other);
 
@@ -112,7 +130,9 @@ namespace occa {
 
     kernelArg getArg(const std::string &name) const;
 
+    // Memoized until props or args change
     hash_t hash() const;
+    bool hasCachedHash() const;
   };
 
   template <>
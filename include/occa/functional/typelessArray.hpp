@@ -1,9 +1,12 @@
 #ifndef OCCA_FUNCTIONAL_TYPELESSARRAY_HEADER
 #define OCCA_FUNCTIONAL_TYPELESSARRAY_HEADER
 
+#include <sstream>
+
 #include <occa/defines/okl.hpp>
 #include <occa/dtype.hpp>
 #include <occa/core.hpp>
+#include <occa/functional/asyncValue.hpp>
 #include <occa/functional/function.hpp>
 #include <occa/functional/utils.hpp>
 #include <occa/experimental/kernelBuilder.hpp>
@@ -18,6 +21,7 @@ namespace occa {
 
     int tileSize;
     int tileIterations;
+    bool lengthSpecialization;
 
     // Buffer memory
     mutable occa::memory returnMemory;
@@ -51,7 +55,31 @@ namespace occa {
       return occa::scope();
     }
 
+    // Length-dependent values are passed as kernel arguments so arrays of any length
+    //   share kernels, unless the array opted into length-specialized kernels
+    void addLengthParameter(occa::scope &scope,
+                            const std::string &defineName,
+                            const std::string &argName,
+                            const int value) const {
+      if (lengthSpecialization) {
+        scope.setProp("defines/" + defineName, value);
+      } else {
+        scope.add(argName, value);
+        scope.setProp("defines/" + defineName, argName);
+      }
+    }
+
     occa::scope getMapArrayScope(const baseFunction &fn) const {
+      occa::scope functionScope = fn.scope;
+      functionScope.setProp("functions/occa_array_function", fn);
+
+      return getMapArrayScope(buildMapFunctionCall(fn), functionScope);
+    }
+
+    // [functionCall] expands OCCA_ARRAY_FUNCTION(VALUE, INDEX, VALUES_PTR) with the
+    //   functions and arguments it uses found in [functionScope]
+    occa::scope getMapArrayScope(const std::string &functionCall,
+                                 const occa::scope &functionScope) const {
       const int arrayLength = (int) length();
 
       const int safeTileSize = std::min(
@@ -72,20 +100,19 @@ namespace occa {
         {"occa_array_return", returnMemory}
       }, {
         {"defines/T", dtype_.name()},
-        {"defines/OCCA_ARRAY_TILE_SIZE", safeTileSize},
-        {"defines/OCCA_ARRAY_TILE_ITERATIONS", safeTileIterations},
-        {"defines/OCCA_ARRAY_FUNCTION(VALUE, INDEX, VALUES_PTR)", buildMapFunctionCall(fn)},
+        {"defines/OCCA_ARRAY_FUNCTION(VALUE, INDEX, VALUES_PTR)", functionCall},
         {"defines/OCCA_ARRAY_TILE_FOR_LOOP", tileForLoop},
-        {"defines/OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP", parallelForLoop},
-        {"functions/occa_array_function", fn}
+        {"defines/OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP", parallelForLoop}
       });
 
       baseScope.device = device_;
+      addLengthParameter(baseScope, "OCCA_ARRAY_TILE_SIZE", "occa_array_tile_size", safeTileSize);
+      addLengthParameter(baseScope, "OCCA_ARRAY_TILE_ITERATIONS", "occa_array_tile_iterations", safeTileIterations);
 
       return (
         baseScope
         + getMapArrayScopeOverrides()
-        + fn.scope
+        + functionScope
       );
     }
 
@@ -93,16 +120,18 @@ namespace occa {
     occa::scope getCpuReduceArrayScope(reductionType type,
                                        const T2 &localInit,
                                        const bool useLocalInit,
-                                       const baseFunction &fn) const {
+                                       const baseFunction &fn,
+                                       int &reductionCount) const {
       const int arrayLength = (int) length();
       const int ompLoopSize = 128;
 
       setupReturnMemoryArray<T2>(ompLoopSize);
+      reductionCount = ompLoopSize;
 
       occa::json props({
         {"defines/T", dtype_.name()},
         {"defines/T2", dtype::get<T2>().name()},
-        {"defines/OCCA_ARRAY_OMP_LOOP_SIZE", 128},
+        {"defines/OCCA_ARRAY_OMP_LOOP_SIZE", ompLoopSize},
         {"defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)", buildReduceFunctionCall(fn)},
         {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
         {"functions/occa_array_function", fn}
@@ -132,7 +161,8 @@ namespace occa {
     occa::scope getGpuReduceArrayScope(reductionType type,
                                        const T2 &localInit,
                                        const bool useLocalInit,
-                                       const baseFunction &fn) const {
+                                       const baseFunction &fn,
+                                       int &reductionCount) const {
       const int arrayLength = (int) length();
 
       // Default and limit to 1024 if not set
@@ -142,8 +172,11 @@ namespace occa {
         : std::min(1024, tileSize)
       );
 
-      // Limit it to the array length
-      unsafeTileSize = std::min(unsafeTileSize, arrayLength);
+      // The tile size sizes the shared memory and has to be known at compile-time,
+      //   so it's only limited to the array length for length-specialized kernels
+      if (lengthSpecialization) {
+        unsafeTileSize = std::min(unsafeTileSize, arrayLength);
+      }
 
       // Make sure it's a power of 2
       int safeTileSize = 1024;
@@ -166,12 +199,12 @@ namespace occa {
       const int localReductionCount = (arrayLength + localReductionSize - 1) / localReductionSize;
 
       setupReturnMemoryArray<T2>(localReductionCount);
+      reductionCount = localReductionCount;
 
       occa::json props({
         {"defines/T", dtype_.name()},
         {"defines/T2", dtype::get<T2>().name()},
         {"defines/OCCA_ARRAY_TILE_SIZE", safeTileSize},
-        {"defines/OCCA_ARRAY_TILE_ITERATIONS", safeTileIterations},
         {"defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)", buildReduceFunctionCall(fn)},
         {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
         {"defines/OCCA_ARRAY_SHARED_REDUCTION(BOUNDS)",
@@ -197,6 +230,7 @@ namespace occa {
       }, props);
 
       baseScope.device = device_;
+      addLengthParameter(baseScope, "OCCA_ARRAY_TILE_ITERATIONS", "occa_array_tile_iterations", safeTileIterations);
 
       return (
         baseScope
@@ -205,6 +239,167 @@ namespace occa {
       );
     }
 
+    template <class T2>
+    occa::scope getMultiReduceArrayScope(const std::vector<reductionType> &types,
+                                         const baseFunction *fn,
+                                         int &reductionCount) const {
+      const int arrayLength = (int) length();
+      const int typeCount = (int) types.size();
+
+      // CPU threads reduce contiguous chunks while GPU threads stride through the array
+      const bool contiguousChunks = usingNativeCpuMode();
+      const int blockCount = contiguousChunks ? 128 : 64;
+      const int blockSize = contiguousChunks ? 1 : 256;
+
+      reductionCount = blockCount * blockSize;
+      setupReturnMemoryArray<T2>(typeCount * reductionCount);
+
+      std::stringstream init, accumulate, store;
+      for (int i = 0; i < typeCount; ++i) {
+        const std::string acc = "occa_array_acc_" + std::to_string(i);
+        const std::string localReduction = "OCCA_ARRAY_LOCAL_REDUCTION_" + std::to_string(i);
+
+        // Reductions seeded with a value start from the first (mapped) value
+        init << "T2 " << acc << " = " << buildReductionInitValue(types[i], "OCCA_ARRAY_FUNCTION_CALL(0, 0)") << ";";
+        accumulate << acc << " = " << localReduction << "(" << acc << ", VALUE);";
+        store << "occa_array_return[(" << i << " * STRIDE) + INDEX] = " << acc << ";";
+      }
+
+      occa::json props({
+        {"defines/T", dtype_.name()},
+        {"defines/T2", dtype::get<T2>().name()},
+        {"defines/OCCA_ARRAY_CONTIGUOUS_CHUNKS", contiguousChunks ? 1 : 0},
+        {"defines/OCCA_ARRAY_BLOCK_COUNT", blockCount},
+        {"defines/OCCA_ARRAY_BLOCK_SIZE", blockSize},
+        {"defines/OCCA_ARRAY_MULTI_INIT", init.str()},
+        {"defines/OCCA_ARRAY_MULTI_ACCUMULATE(VALUE)", accumulate.str()},
+        {"defines/OCCA_ARRAY_MULTI_STORE(INDEX, STRIDE)", store.str()}
+      });
+      for (int i = 0; i < typeCount; ++i) {
+        props["defines/OCCA_ARRAY_LOCAL_REDUCTION_" + std::to_string(i) + "(LEFT_VALUE, RIGHT_VALUE)"] = (
+          buildLocalReductionOperation(types[i])
+        );
+      }
+
+      // Reduce the (optionally mapped) values directly
+      if (fn) {
+        props["defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)"] = buildMapFunctionCall(*fn);
+        props["functions/occa_array_function"] = *fn;
+      } else {
+        props["defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)"] = "(VALUE)";
+      }
+
+      occa::scope baseScope({
+        {"occa_array_length", arrayLength},
+        {"occa_array_return", returnMemory}
+      }, props);
+
+      baseScope.device = device_;
+
+      occa::scope scope = baseScope + getReduceArrayScopeOverrides();
+      if (fn) {
+        scope += fn->scope;
+      }
+      return scope;
+    }
+
+    // Each scan thread handles a contiguous chunk, CPU modes use one thread per block
+    int scanBlockCount() const {
+      return usingNativeCpuMode() ? 128 : 64;
+    }
+
+    int scanBlockSize() const {
+      return usingNativeCpuMode() ? 1 : 256;
+    }
+
+    // The scan total is stored after the per-thread partials
+    int getScanTotal() const {
+      int total = 0;
+      returnMemory.copyTo(&total,
+                          sizeof(int),
+                          sizeof(int) * scanBlockCount() * scanBlockSize());
+      return total;
+    }
+
+    template <class T2>
+    occa::scope getScanArrayScope(reductionType type,
+                                  const T2 &initValue,
+                                  const std::string &scanValue,
+                                  const std::string &scanWrite,
+                                  const baseFunction *fn) const {
+      const int arrayLength = (int) length();
+
+      const int blockCount = scanBlockCount();
+      const int blockSize = scanBlockSize();
+      const int threadCount = blockCount * blockSize;
+
+      // Per-thread partials with the total stored at the end
+      setupReturnMemoryArray<T2>(threadCount + 1);
+
+      occa::json props({
+        {"defines/T", dtype_.name()},
+        {"defines/T2", dtype::get<T2>().name()},
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_COUNT", blockCount},
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_SIZE", blockSize},
+        {"defines/OCCA_ARRAY_SCAN_THREAD_COUNT", threadCount},
+        {"defines/OCCA_ARRAY_SCAN_IDENTITY", buildReductionInitValue(type)},
+        {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
+        {"defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)", scanValue},
+        {"defines/OCCA_ARRAY_SCAN_WRITE(INDEX, VALUE, PREFIX, ACC)", scanWrite}
+      });
+
+      if (fn) {
+        props["functions/occa_array_function"] = *fn;
+      }
+
+      occa::scope baseScope({
+        {"occa_array_length", arrayLength},
+        {"occa_array_return", returnMemory},
+        {"occa_array_scan_init", initValue}
+      }, props);
+
+      baseScope.device = device_;
+
+      occa::scope scope = baseScope + getReduceArrayScopeOverrides();
+      if (fn) {
+        scope += fn->scope;
+      }
+      return scope;
+    }
+
+    template <class T2>
+    occa::scope getFinishReductionScope(reductionType type,
+                                        occa::memory partials,
+                                        const int reductionCount,
+                                        occa::memory output) const {
+      // Matches the shared reductions in finishReturnMemoryReduction
+      const int finishTileSize = 256;
+
+      occa::json props({
+        {"defines/T2", dtype::get<T2>().name()},
+        {"defines/OCCA_ARRAY_TILE_SIZE", finishTileSize},
+        {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
+        {"defines/OCCA_ARRAY_PARTIAL_REDUCTION(BOUNDS)",
+         "for (int i = 0; i < OCCA_ARRAY_TILE_SIZE; ++i; @inner) {"
+         "  if ((i < BOUNDS) && (i + BOUNDS < occa_array_reduction_count)) {"
+         "    const T2 leftValue = tileAcc[i];"
+         "    const T2 rightValue = tileAcc[i + BOUNDS];"
+         "    tileAcc[i] = OCCA_ARRAY_LOCAL_REDUCTION(leftValue, rightValue);"
+         "  }"
+         "}"}
+      });
+
+      occa::scope baseScope({
+        {"occa_array_reduction_count", reductionCount},
+        {"occa_array_return", partials},
+        {"occa_array_output", output}
+      }, props);
+
+      baseScope.device = device_;
+
+      return baseScope;
+    }
+
     std::string buildMapFunctionCall(const baseFunction &fn) const {
       return buildFunctionCall(fn, true);
     }
@@ -273,6 +468,12 @@ namespace occa {
     virtual std::string reductionInitialValue() const = 0;
 
     std::string buildReductionInitValue(reductionType type) const {
+      return buildReductionInitValue(type, reductionInitialValue());
+    }
+
+    // [firstValue] seeds reductions without an identity value, such as min and max
+    std::string buildReductionInitValue(reductionType type,
+                                        const std::string &firstValue) const {
       switch (type) {
         case reductionType::sum:
           return "0";
@@ -281,17 +482,17 @@ namespace occa {
         case reductionType::bitOr:
           return "0";
         case reductionType::bitAnd:
-          return reductionInitialValue();
+          return firstValue;
         case reductionType::bitXor:
           return "0";
         case reductionType::boolOr:
           return "0";
         case reductionType::boolAnd:
-          return reductionInitialValue();
+          return firstValue;
         case reductionType::min:
-          return reductionInitialValue();
+          return firstValue;
         case reductionType::max:
-          return reductionInitialValue();
+          return firstValue;
         default:
           // Shouldn't get here
           return "";
@@ -332,13 +533,15 @@ namespace occa {
   public:
     typelessArray() :
       tileSize(-1),
-      tileIterations(-1) {}
+      tileIterations(-1),
+      lengthSpecialization(false) {}
 
     typelessArray(const typelessArray &other) :
       device_(other.device_),
       dtype_(other.dtype_),
       tileSize(other.tileSize),
-      tileIterations(other.tileIterations) {}
+      tileIterations(other.tileIterations),
+      lengthSpecialization(other.lengthSpecialization) {}
 
     typelessArray& operator = (const typelessArray &other) {
       device_ = other.device_;
@@ -346,6 +549,7 @@ namespace occa {
 
       tileSize = other.tileSize;
       tileIterations = other.tileIterations;
+      lengthSpecialization = other.lengthSpecialization;
 
       return *this;
     }
@@ -380,6 +584,16 @@ namespace occa {
       }
     }
 
+    // Bakes the array length into the tiling of map and reduce kernels, which
+    //   builds a new kernel for each array length
+    void setLengthSpecialization(const bool lengthSpecialization_) {
+      lengthSpecialization = lengthSpecialization_;
+    }
+
+    bool usingLengthSpecialization() const {
+      return lengthSpecialization;
+    }
+
     //---[ Memory methods ]-------------
     occa::device getDevice() const {
       return device_;
@@ -462,7 +676,11 @@ namespace occa {
       occa::scope arrayScope = getMapArrayScope(fn);
       arrayScope.add("occa_array_output", output);
 
-      OCCA_JIT(arrayScope, (
+      runMapTo(arrayScope);
+    }
+
+    void runMapTo(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
         OCCA_ARRAY_TILE_FOR_LOOP {
           OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP {
             occa_array_output[i] = OCCA_ARRAY_FUNCTION_CALL(i);
@@ -476,20 +694,732 @@ namespace occa {
                        const T2 &localInit,
                        const bool useLocalInit,
                        const baseFunction &fn) const {
+      // Without an output, the final value is written to the start of returnMemory
+      typelessReduceTo<T2>(occa::memory(), type, localInit, useLocalInit, fn);
+
+      T2 returnValue;
+      setReturnValue(returnValue);
+
+      return returnValue;
+    }
+
+    template <class T2>
+    asyncValue<T2> typelessReduceAsync(reductionType type,
+                                       const T2 &localInit,
+                                       const bool useLocalInit,
+                                       const baseFunction &fn) const {
+      // Each pending value needs its own output since the partial reductions are reused
+      occa::memory output = device_.template malloc<T2>(1);
+
+      typelessReduceTo<T2>(output, type, localInit, useLocalInit, fn);
+
+      return asyncValue<T2>(output);
+    }
+
+    template <class T2>
+    void typelessReduceTo(occa::memory output,
+                          reductionType type,
+                          const T2 &localInit,
+                          const bool useLocalInit,
+                          const baseFunction &fn) const {
+      int reductionCount;
+      if (usingNativeCpuMode()) {
+        reductionCount = typelessCpuReduce<T2>(type, localInit, useLocalInit, fn);
+      } else {
+        reductionCount = typelessGpuReduce<T2>(type, localInit, useLocalInit, fn);
+      }
+
+      finishReturnMemoryReduction<T2>(
+        type,
+        reductionCount,
+        output.isInitialized() ? output : returnMemory
+      );
+    }
+
+    template <class T2>
+    std::vector<T2> typelessReduceMany(const std::vector<reductionType> &types,
+                                       const baseFunction *fn) const {
+      const int typeCount = (int) types.size();
+      if (!typeCount) {
+        return std::vector<T2>();
+      }
+
+      int reductionCount;
+      occa::scope scope = getMultiReduceArrayScope<T2>(types, fn, reductionCount);
+
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < OCCA_ARRAY_BLOCK_COUNT; ++blockIndex; @outer) {
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_BLOCK_SIZE; ++localIndex; @inner) {
+            const int threadCount = OCCA_ARRAY_BLOCK_COUNT * OCCA_ARRAY_BLOCK_SIZE;
+            const int threadIndex = (blockIndex * OCCA_ARRAY_BLOCK_SIZE) + localIndex;
+
+            const int chunkSize = (
+              OCCA_ARRAY_CONTIGUOUS_CHUNKS
+              ? (occa_array_length + threadCount - 1) / threadCount
+              : 1
+            );
+            const int startIndex = (
+              OCCA_ARRAY_CONTIGUOUS_CHUNKS
+              ? threadIndex * chunkSize
+              : threadIndex
+            );
+            const int unsafeEndIndex = (
+              OCCA_ARRAY_CONTIGUOUS_CHUNKS
+              ? startIndex + chunkSize
+              : occa_array_length
+            );
+            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+            const int indexStep = OCCA_ARRAY_CONTIGUOUS_CHUNKS ? 1 : threadCount;
+
+            OCCA_ARRAY_MULTI_INIT
+
+            for (int i = startIndex; i < endIndex; i += indexStep) {
+              const T2 value = OCCA_ARRAY_FUNCTION_CALL(0, i);
+              OCCA_ARRAY_MULTI_ACCUMULATE(value)
+            }
+
+            OCCA_ARRAY_MULTI_STORE(threadIndex, threadCount)
+          }
+        }
+      ));
+
+      // Reduction i is written to returnMemory[i], after the partials it overwrites were consumed
+      for (int i = 0; i < typeCount; ++i) {
+        finishReduction<T2>(types[i],
+                            returnMemory.slice(i * reductionCount, reductionCount),
+                            reductionCount,
+                            returnMemory.slice(i, 1));
+      }
+
+      T2 *values = new T2[typeCount];
+      returnMemory.copyTo(values, typeCount * sizeof(T2));
+      std::vector<T2> returnValues(values, values + typeCount);
+      delete [] values;
+
+      return returnValues;
+    }
+
+    template <class T2>
+    T2 typelessMapReduce(reductionType type,
+                         const baseFunction &mapFn) const {
+      return typelessReduceMany<T2>({type}, &mapFn)[0];
+    }
+
+    template <class T2>
+    T2 typelessMapReduce(reductionType type,
+                         const baseFunction &mapFn,
+                         const baseFunction &reduceFn) const {
+      strVector mapArguments = {"VALUE", "INDEX", "VALUES_PTR"};
+      mapArguments.resize(mapFn.argumentCount());
+
+      occa::scope mapScope = mapFn.scope;
+      mapScope.setProp("functions/occa_array_map_function", mapFn);
+
+      strVector firstArguments = {reductionInitialValue(), "0", "occa_array_ptr"};
+      firstArguments.resize(mapFn.argumentCount());
+
+      return typelessMapReduce<T2>(type, T2(), false,
+                                   mapFn.buildFunctionCall("occa_array_map_function", mapArguments),
+                                   mapFn.buildFunctionCall("occa_array_map_function", firstArguments),
+                                   mapScope,
+                                   reduceFn);
+    }
+
+    // [mapCall] expands to the mapped value from VALUE, INDEX and VALUES_PTR and
+    //   [firstMapCall] to the mapped first value, with the functions and arguments
+    //   they use found in [mapScope]
+    template <class T2>
+    T2 typelessMapReduce(reductionType type,
+                         const T2 &localInit,
+                         const bool useLocalInit,
+                         const std::string &mapCall,
+                         const std::string &firstMapCall,
+                         const occa::scope &mapScope,
+                         const baseFunction &reduceFn) const {
+      int reductionCount;
+      occa::scope scope;
       if (usingNativeCpuMode()) {
-        return typelessCpuReduce<T2>(type, localInit, useLocalInit, fn);
+        scope = getCpuReduceArrayScope<T2>(type, localInit, useLocalInit, reduceFn, reductionCount);
+      } else {
+        scope = getGpuReduceArrayScope<T2>(type, localInit, useLocalInit, reduceFn, reductionCount);
+      }
+
+      // Feed the mapped value to the reduction function
+      strVector reduceArguments = {"ACC", mapCall, "INDEX"};
+      reduceArguments.resize(reduceFn.argumentCount());
+
+      scope.setProp(
+        "defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)",
+        reduceFn.buildFunctionCall("occa_array_function", reduceArguments)
+      );
+      if (!useLocalInit) {
+        scope.setProp("defines/OCCA_ARRAY_REDUCTION_INIT_VALUE", buildReductionInitValue(type, firstMapCall));
+      }
+      scope += mapScope;
+
+      if (usingNativeCpuMode()) {
+        runCpuReduce(scope);
+      } else {
+        runGpuReduce(scope);
+      }
+      finishReturnMemoryReduction<T2>(type, reductionCount, returnMemory);
+
+      T2 returnValue;
+      setReturnValue(returnValue);
+
+      return returnValue;
+    }
+
+    template <class T2>
+    occa::memory typelessScan(reductionType type,
+                              const bool exclusive,
+                              const T2 &initValue) const {
+      occa::memory output = device_.template malloc<T2>(length());
+      if (!length()) {
+        return output;
+      }
+
+      occa::scope scope = getScanArrayScope<T2>(
+        type,
+        initValue,
+        "(VALUE)",
+        exclusive ? "occa_array_output[INDEX] = PREFIX;" : "occa_array_output[INDEX] = ACC;",
+        NULL
+      );
+      scope.add("occa_array_output", output);
+
+      runScanReduce(scope);
+      runScanPartials(scope);
+      runScanWrite(scope);
+
+      return output;
+    }
+
+    // Stable stream compaction, keeping values where fn is true
+    template <class T2>
+    occa::memory typelessFilter(const baseFunction &fn) const {
+      if (!length()) {
+        return device_.template malloc<T2>(0);
+      }
+
+      occa::scope scope = getScanArrayScope<int>(
+        reductionType::sum,
+        0,
+        "(" + buildMapFunctionCall(fn) + " ? 1 : 0)",
+        "if (VALUE) { occa_array_output[PREFIX] = occa_array_ptr[INDEX]; }",
+        &fn
+      );
+
+      runScanReduce(scope);
+      runScanPartials(scope);
+
+      // The output size is only known after counting the kept values
+      const int outputLength = getScanTotal();
+
+      occa::memory output = device_.template malloc<T2>(outputLength);
+      if (outputLength) {
+        scope.add("occa_array_output", output);
+        runScanWrite(scope);
+      }
+
+      return output;
+    }
+
+    // Stable partition with values where fn is true placed first
+    template <class T2>
+    occa::memory typelessPartition(const baseFunction &fn,
+                                   int &trueCount) const {
+      occa::memory output = device_.template malloc<T2>(length());
+      if (!length()) {
+        trueCount = 0;
+        return output;
+      }
+
+      occa::scope scope = getScanArrayScope<int>(
+        reductionType::sum,
+        0,
+        "(" + buildMapFunctionCall(fn) + " ? 1 : 0)",
+        "if (VALUE) {"
+        "  occa_array_output[PREFIX] = occa_array_ptr[INDEX];"
+        "} else {"
+        "  occa_array_output[occa_array_return[OCCA_ARRAY_SCAN_THREAD_COUNT] + INDEX - PREFIX] = occa_array_ptr[INDEX];"
+        "}",
+        &fn
+      );
+      scope.add("occa_array_output", output);
+
+      runScanReduce(scope);
+      runScanPartials(scope);
+      runScanWrite(scope);
+
+      trueCount = getScanTotal();
+
+      return output;
+    }
+
+    // Block-scan + propagation:
+    //   1. Each thread reduces its chunk into occa_array_return[thread]
+    //   2. A single block scans the partials in place and stores the total
+    //   3. Each thread rescans its chunk starting from its partial
+    void runScanReduce(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < OCCA_ARRAY_SCAN_BLOCK_COUNT; ++blockIndex; @outer) {
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int threadIndex = (blockIndex * OCCA_ARRAY_SCAN_BLOCK_SIZE) + localIndex;
+            const int chunkSize = (
+              (occa_array_length + OCCA_ARRAY_SCAN_THREAD_COUNT - 1) / OCCA_ARRAY_SCAN_THREAD_COUNT
+            );
+            const int startIndex = threadIndex * chunkSize;
+            const int unsafeEndIndex = startIndex + chunkSize;
+            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+
+            T2 acc = OCCA_ARRAY_SCAN_IDENTITY;
+            for (int i = startIndex; i < endIndex; ++i) {
+              const T2 value = OCCA_ARRAY_FUNCTION_CALL(0, i);
+              acc = (OCCA_ARRAY_LOCAL_REDUCTION(acc, value));
+            }
+            occa_array_return[threadIndex] = acc;
+          }
+        }
+      ));
+    }
+
+    void runScanPartials(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < 1; ++blockIndex; @outer) {
+          @shared T2 threadTotals[OCCA_ARRAY_SCAN_BLOCK_SIZE];
+
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int startIndex = localIndex * OCCA_ARRAY_SCAN_BLOCK_COUNT;
+            T2 acc = OCCA_ARRAY_SCAN_IDENTITY;
+            for (int i = startIndex; i < startIndex + OCCA_ARRAY_SCAN_BLOCK_COUNT; ++i) {
+              const T2 value = occa_array_return[i];
+              acc = (OCCA_ARRAY_LOCAL_REDUCTION(acc, value));
+            }
+            threadTotals[localIndex] = acc;
+          }
+
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            if (localIndex == 0) {
+              T2 acc = OCCA_ARRAY_SCAN_IDENTITY;
+              for (int i = 0; i < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++i) {
+                const T2 value = threadTotals[i];
+                threadTotals[i] = acc;
+                acc = (OCCA_ARRAY_LOCAL_REDUCTION(acc, value));
+              }
+              occa_array_return[OCCA_ARRAY_SCAN_THREAD_COUNT] = acc;
+            }
+          }
+
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int startIndex = localIndex * OCCA_ARRAY_SCAN_BLOCK_COUNT;
+            T2 acc = threadTotals[localIndex];
+            for (int i = startIndex; i < startIndex + OCCA_ARRAY_SCAN_BLOCK_COUNT; ++i) {
+              const T2 value = occa_array_return[i];
+              occa_array_return[i] = acc;
+              acc = (OCCA_ARRAY_LOCAL_REDUCTION(acc, value));
+            }
+          }
+        }
+      ));
+    }
+
+    void runScanWrite(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < OCCA_ARRAY_SCAN_BLOCK_COUNT; ++blockIndex; @outer) {
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int threadIndex = (blockIndex * OCCA_ARRAY_SCAN_BLOCK_SIZE) + localIndex;
+            const int chunkSize = (
+              (occa_array_length + OCCA_ARRAY_SCAN_THREAD_COUNT - 1) / OCCA_ARRAY_SCAN_THREAD_COUNT
+            );
+            const int startIndex = threadIndex * chunkSize;
+            const int unsafeEndIndex = startIndex + chunkSize;
+            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+
+            // Inclusive (acc) and exclusive (prefix) scan values
+            const T2 offset = occa_array_return[threadIndex];
+            T2 acc = offset;
+            T2 prefix = (
+              threadIndex == 0
+              ? occa_array_scan_init
+              : (OCCA_ARRAY_LOCAL_REDUCTION(occa_array_scan_init, offset))
+            );
+            for (int i = startIndex; i < endIndex; ++i) {
+              const T2 value = OCCA_ARRAY_FUNCTION_CALL(0, i);
+              acc = (OCCA_ARRAY_LOCAL_REDUCTION(acc, value));
+              OCCA_ARRAY_SCAN_WRITE(i, value, prefix, acc)
+              prefix = (OCCA_ARRAY_LOCAL_REDUCTION(prefix, value));
+            }
+          }
+        }
+      ));
+    }
+
+    // Radix keys are the raw value bits, stored in a signed type of the same size
+    //   and reinterpreted as unsigned inside the kernels
+    dtype_t getRadixKeyDtype(const int keyBytes) const {
+      switch (keyBytes) {
+        case 1: return dtype::get<int8_t>();
+        case 2: return dtype::get<int16_t>();
+        case 4: return dtype::get<int32_t>();
+        default: return dtype::get<int64_t>();
+      }
+    }
+
+    std::string getRadixKeyType(const int keyBytes) const {
+      switch (keyBytes) {
+        case 1: return "unsigned char";
+        case 2: return "unsigned short";
+        case 4: return "unsigned int";
+        default: return "unsigned long long";
+      }
+    }
+
+    occa::scope getRadixSortScope(const int keyBytes,
+                                  const int radixBuckets,
+                                  const bool hasValues) const {
+      const int blockCount = scanBlockCount();
+      const int blockSize = scanBlockSize();
+      const int threadCount = blockCount * blockSize;
+
+      // Digit counts stored digit-major so their exclusive scan gives scatter offsets
+      setupReturnMemoryArray<int>(radixBuckets * threadCount + 1);
+
+      occa::json props({
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_COUNT", blockCount},
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_SIZE", blockSize},
+        {"defines/OCCA_ARRAY_SCAN_THREAD_COUNT", threadCount},
+        {"defines/OCCA_ARRAY_SORT_KEY", getRadixKeyType(keyBytes)},
+        {"defines/OCCA_ARRAY_SORT_BUCKETS", radixBuckets},
+        {"defines/OCCA_ARRAY_SORT_DIGIT(KEY)",
+         "((KEY >> occa_array_sort_shift) & (OCCA_ARRAY_SORT_BUCKETS - 1))"}
+      });
+
+      if (hasValues) {
+        props["defines/OCCA_ARRAY_SORT_MOVE_VALUE(FROM, TO)"] = (
+          "occa_array_values_output[TO] = occa_array_values[FROM];"
+        );
+      } else {
+        props["defines/OCCA_ARRAY_SORT_MOVE_VALUE(FROM, TO)"] = "";
+      }
+
+      occa::scope scope({
+        {"occa_array_length", (int) length()},
+        {"occa_array_return", returnMemory}
+      }, props);
+
+      scope.device = device_;
+
+      return scope;
+    }
+
+    // Stable LSD radix sort on the lowest bitCount key bits, moving the values
+    //   (if initialized) along with their keys
+    void radixSortPairs(occa::memory &keys,
+                        occa::memory &values,
+                        const int keyBytes,
+                        const int bitCount) const {
+      const bool hasValues = values.isInitialized();
+
+      occa::memory keysOutput = device_.malloc(keys.size());
+      keysOutput.setDtype(keys.dtype());
+
+      occa::memory valuesOutput;
+      if (hasValues) {
+        valuesOutput = device_.malloc(values.size());
+        valuesOutput.setDtype(values.dtype());
+      }
+
+      // Sort 4 bits per pass
+      const int radixBits = 4;
+      const int radixBuckets = 1 << radixBits;
+
+      const int blockCount = scanBlockCount();
+      const int blockSize = scanBlockSize();
+      const int threadCount = blockCount * blockSize;
+
+      occa::scope scope = getRadixSortScope(keyBytes, radixBuckets, hasValues);
+
+      occa::scope histogramScope({
+        {"occa_array_length", (int) length()},
+        {"occa_array_return", returnMemory}
+      }, {
+        {"defines/T2", "int"},
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_COUNT", radixBuckets * blockCount},
+        {"defines/OCCA_ARRAY_SCAN_BLOCK_SIZE", blockSize},
+        {"defines/OCCA_ARRAY_SCAN_THREAD_COUNT", radixBuckets * threadCount},
+        {"defines/OCCA_ARRAY_SCAN_IDENTITY", 0},
+        {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)",
+         buildLocalReductionOperation(reductionType::sum)}
+      });
+      histogramScope.device = device_;
+
+      for (int shift = 0; shift < bitCount; shift += radixBits) {
+        occa::scope passScope = scope;
+        passScope.add("occa_array_sort_shift", shift);
+        passScope.add("occa_array_keys", keys);
+        passScope.add("occa_array_keys_output", keysOutput);
+        if (hasValues) {
+          passScope.add("occa_array_values", values);
+          passScope.add("occa_array_values_output", valuesOutput);
+        }
+
+        runRadixSortCount(passScope);
+        runScanPartials(histogramScope);
+        runRadixSortScatter(passScope);
+
+        std::swap(keys, keysOutput);
+        std::swap(values, valuesOutput);
+      }
+    }
+
+    // Maps keys to unsigned bits with the same ordering and back
+    void transformRadixKeys(occa::memory keys,
+                            const int keyBytes,
+                            const bool isFloat,
+                            const bool isSigned,
+                            const bool encode) const {
+      std::string transform;
+      if (isFloat) {
+        transform = (
+          encode
+          ? "(KEY & sign) ? (~KEY) : (KEY | sign)"
+          : "(KEY & sign) ? (KEY ^ sign) : (~KEY)"
+        );
+      } else if (isSigned) {
+        transform = "KEY ^ sign";
       } else {
-        return typelessGpuReduce<T2>(type, localInit, useLocalInit, fn);
+        return;
       }
+
+      occa::scope scope({
+        {"occa_array_length", (int) length()},
+        {"occa_array_keys", keys}
+      }, {
+        {"defines/OCCA_ARRAY_SORT_KEY", getRadixKeyType(keyBytes)},
+        {"defines/OCCA_ARRAY_SORT_SIGN_SHIFT", 8 * keyBytes - 1},
+        {"defines/OCCA_ARRAY_SORT_TRANSFORM(KEY)", transform}
+      });
+      scope.device = device_;
+
+      OCCA_JIT(scope, (
+        for (int i = 0; i < occa_array_length; ++i; @tile(256, @outer, @inner)) {
+          const OCCA_ARRAY_SORT_KEY one = 1;
+          const OCCA_ARRAY_SORT_KEY sign = one << OCCA_ARRAY_SORT_SIGN_SHIFT;
+          const OCCA_ARRAY_SORT_KEY key = occa_array_keys[i];
+          const OCCA_ARRAY_SORT_KEY transformedKey = OCCA_ARRAY_SORT_TRANSFORM(key);
+          occa_array_keys[i] = transformedKey;
+        }
+      ));
     }
 
+    // Sorts the raw value bits in keys, moving values (if initialized) along with them
+    void typelessRadixSort(occa::memory &keys,
+                           occa::memory &values,
+                           const int keyBytes,
+                           const bool isFloat,
+                           const bool isSigned) const {
+      if (!length()) {
+        return;
+      }
+
+      keys = keys.cast(getRadixKeyDtype(keyBytes));
+
+      transformRadixKeys(keys, keyBytes, isFloat, isSigned, true);
+      radixSortPairs(keys, values, keyBytes, 8 * keyBytes);
+      transformRadixKeys(keys, keyBytes, isFloat, isSigned, false);
+    }
+
+    // Sorts each [offsets[i], offsets[i + 1]) segment by sorting on the keys
+    //   and then stably on the segment ids
+    void typelessSegmentedRadixSort(occa::memory &keys,
+                                    occa::memory segmentOffsets,
+                                    const int segmentCount,
+                                    const int keyBytes,
+                                    const bool isFloat,
+                                    const bool isSigned) const {
+      if (!length() || segmentCount <= 1) {
+        occa::memory values;
+        typelessRadixSort(keys, values, keyBytes, isFloat, isSigned);
+        return;
+      }
+
+      occa::memory segmentIds = device_.template malloc<int>(length());
+
+      occa::scope scope({
+        {"occa_array_segment_count", segmentCount},
+        {"occa_array_segment_offsets", segmentOffsets},
+        {"occa_array_segment_ids", segmentIds}
+      });
+      scope.device = device_;
+
+      OCCA_JIT(scope, (
+        for (int segment = 0; segment < occa_array_segment_count; ++segment; @tile(256, @outer, @inner)) {
+          const int segmentEnd = occa_array_segment_offsets[segment + 1];
+          for (int i = occa_array_segment_offsets[segment]; i < segmentEnd; ++i) {
+            occa_array_segment_ids[i] = segment;
+          }
+        }
+      ));
+
+      int segmentBits = 0;
+      while ((1 << segmentBits) < segmentCount) {
+        ++segmentBits;
+      }
+
+      keys = keys.cast(getRadixKeyDtype(keyBytes));
+
+      transformRadixKeys(keys, keyBytes, isFloat, isSigned, true);
+      radixSortPairs(keys, segmentIds, keyBytes, 8 * keyBytes);
+      radixSortPairs(segmentIds, keys, sizeof(int), segmentBits);
+      transformRadixKeys(keys, keyBytes, isFloat, isSigned, false);
+    }
+
+    void runRadixSortCount(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < OCCA_ARRAY_SCAN_BLOCK_COUNT; ++blockIndex; @outer) {
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int threadIndex = (blockIndex * OCCA_ARRAY_SCAN_BLOCK_SIZE) + localIndex;
+            const int chunkSize = (
+              (occa_array_length + OCCA_ARRAY_SCAN_THREAD_COUNT - 1) / OCCA_ARRAY_SCAN_THREAD_COUNT
+            );
+            const int startIndex = threadIndex * chunkSize;
+            const int unsafeEndIndex = startIndex + chunkSize;
+            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+
+            int counts[OCCA_ARRAY_SORT_BUCKETS];
+            for (int d = 0; d < OCCA_ARRAY_SORT_BUCKETS; ++d) {
+              counts[d] = 0;
+            }
+            for (int i = startIndex; i < endIndex; ++i) {
+              const OCCA_ARRAY_SORT_KEY key = occa_array_keys[i];
+              const int digit = OCCA_ARRAY_SORT_DIGIT(key);
+              ++counts[digit];
+            }
+            for (int d = 0; d < OCCA_ARRAY_SORT_BUCKETS; ++d) {
+              occa_array_return[(d * OCCA_ARRAY_SCAN_THREAD_COUNT) + threadIndex] = counts[d];
+            }
+          }
+        }
+      ));
+    }
+
+    void runRadixSortScatter(const occa::scope &scope) const {
+      OCCA_JIT(scope, (
+        for (int blockIndex = 0; blockIndex < OCCA_ARRAY_SCAN_BLOCK_COUNT; ++blockIndex; @outer) {
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_SCAN_BLOCK_SIZE; ++localIndex; @inner) {
+            const int threadIndex = (blockIndex * OCCA_ARRAY_SCAN_BLOCK_SIZE) + localIndex;
+            const int chunkSize = (
+              (occa_array_length + OCCA_ARRAY_SCAN_THREAD_COUNT - 1) / OCCA_ARRAY_SCAN_THREAD_COUNT
+            );
+            const int startIndex = threadIndex * chunkSize;
+            const int unsafeEndIndex = startIndex + chunkSize;
+            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+
+            int offsets[OCCA_ARRAY_SORT_BUCKETS];
+            for (int d = 0; d < OCCA_ARRAY_SORT_BUCKETS; ++d) {
+              offsets[d] = occa_array_return[(d * OCCA_ARRAY_SCAN_THREAD_COUNT) + threadIndex];
+            }
+            for (int i = startIndex; i < endIndex; ++i) {
+              const OCCA_ARRAY_SORT_KEY key = occa_array_keys[i];
+              const int digit = OCCA_ARRAY_SORT_DIGIT(key);
+              const int outputIndex = offsets[digit]++;
+              occa_array_keys_output[outputIndex] = occa_array_keys[i];
+              OCCA_ARRAY_SORT_MOVE_VALUE(i, outputIndex)
+            }
+          }
+        }
+      ));
+    }
+
+    // Stable bottom-up merge sort where each value finds its merged position
+    //   by binary searching the neighboring run
+    template <class T2>
+    void typelessMergeSort(occa::memory &values,
+                           const baseFunction &fn) const {
+      const int arrayLength = (int) length();
+      if (arrayLength <= 1) {
+        return;
+      }
+
+      occa::memory output = device_.template malloc<T2>(arrayLength);
+
+      occa::scope scope({
+        {"occa_array_length", arrayLength}
+      }, {
+        {"defines/T", dtype::get<T2>().name()},
+        {"defines/OCCA_ARRAY_COMPARE(LEFT_VALUE, RIGHT_VALUE)",
+         fn.buildFunctionCall("occa_array_function", {"LEFT_VALUE", "RIGHT_VALUE"})},
+        {"functions/occa_array_function", fn}
+      });
+      scope.device = device_;
+      scope += fn.scope;
+
+      for (int width = 1; width < arrayLength; width *= 2) {
+        occa::scope passScope = scope;
+        passScope.add("occa_array_sort_width", width);
+        passScope.add("occa_array_values", values);
+        passScope.add("occa_array_values_output", output);
+
+        OCCA_JIT(passScope, (
+          for (int i = 0; i < occa_array_length; ++i; @tile(256, @outer, @inner)) {
+            const int runStart = (i / (2 * occa_array_sort_width)) * (2 * occa_array_sort_width);
+            const int unsafeMiddle = runStart + occa_array_sort_width;
+            const int unsafeRunEnd = runStart + (2 * occa_array_sort_width);
+            const int middle = occa_array_length < unsafeMiddle ? occa_array_length : unsafeMiddle;
+            const int runEnd = occa_array_length < unsafeRunEnd ? occa_array_length : unsafeRunEnd;
+
+            const T value = occa_array_values[i];
+            int position;
+            if (i < middle) {
+              // Left values go before equal right values
+              int low = middle;
+              int high = runEnd;
+              while (low < high) {
+                const int mid = (low + high) / 2;
+                if (OCCA_ARRAY_COMPARE(occa_array_values[mid], value)) {
+                  low = mid + 1;
+                } else {
+                  high = mid;
+                }
+              }
+              position = (i - runStart) + (low - middle);
+            } else {
+              int low = runStart;
+              int high = middle;
+              while (low < high) {
+                const int mid = (low + high) / 2;
+                if (!OCCA_ARRAY_COMPARE(value, occa_array_values[mid])) {
+                  low = mid + 1;
+                } else {
+                  high = mid;
+                }
+              }
+              position = (i - middle) + (low - runStart);
+            }
+            occa_array_values_output[runStart + position] = value;
+          }
+        ));
+
+        std::swap(values, output);
+      }
+    }
+
+    // Returns the number of partial reductions stored in returnMemory
     template <class T2>
-    T2 typelessCpuReduce(reductionType type,
+    int typelessCpuReduce(reductionType type,
                           const T2 &localInit,
                           const bool useLocalInit,
                           const baseFunction &fn) const {
-      occa::scope scope = getCpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn);
+      int reductionCount;
+      occa::scope scope = getCpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn, reductionCount);
+
+      runCpuReduce(scope);
+
+      return reductionCount;
+    }
 
+    void runCpuReduce(const occa::scope &scope) const {
       OCCA_JIT(scope, (
         for (int ompIndex = 0; ompIndex < OCCA_ARRAY_OMP_LOOP_SIZE; ++ompIndex; @outer) {
           for (int dummyIndex = 0; dummyIndex < 1; ++dummyIndex; @inner) {
@@ -511,17 +1441,23 @@ namespace occa {
           }
         }
       ));
-
-      return finishReturnMemoryReduction<T2>(type);
     }
 
+    // Returns the number of partial reductions stored in returnMemory
     template <class T2>
-    T2 typelessGpuReduce(reductionType type,
+    int typelessGpuReduce(reductionType type,
                           const T2 &localInit,
                           const bool useLocalInit,
                           const baseFunction &fn) const {
-      occa::scope scope = getGpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn);
+      int reductionCount;
+      occa::scope scope = getGpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn, reductionCount);
+
+      runGpuReduce(scope);
 
+      return reductionCount;
+    }
+
+    void runGpuReduce(const occa::scope &scope) const {
       OCCA_JIT(scope, (
         for (int tileIndex = 0;
              tileIndex < occa_array_length;
@@ -534,7 +1470,7 @@ namespace occa {
             T2 localAcc = OCCA_ARRAY_REDUCTION_INIT_VALUE;
 
             for (int i = 0; i < OCCA_ARRAY_TILE_ITERATIONS; ++i) {
-              const int index = tileIndex + (i * OCCA_ARRAY_TILE_ITERATIONS) + localIndex;
+              const int index = tileIndex + (i * OCCA_ARRAY_TILE_SIZE) + localIndex;
               if (index < occa_array_length) {
                 localAcc = OCCA_ARRAY_FUNCTION_CALL(localAcc, index);
               }
@@ -583,20 +1519,80 @@ namespace occa {
             if (i == 0) {
               const T2 leftValue = tileAcc[0];
               const T2 rightValue = tileAcc[1];
-              occa_array_return[tileIndex] = (
+              occa_array_return[tileIndex / (OCCA_ARRAY_TILE_SIZE * OCCA_ARRAY_TILE_ITERATIONS)] = (
                 OCCA_ARRAY_LOCAL_REDUCTION(leftValue, rightValue)
               );
             }
           }
         }
       ));
+    }
 
-      return finishReturnMemoryReduction<T2>(type);
+    // Folds the partial reductions on the device so only one value is copied back
+    template <class T2>
+    void finishReturnMemoryReduction(reductionType type,
+                                     const int reductionCount,
+                                     occa::memory output) const {
+      finishReduction<T2>(type, returnMemory, reductionCount, output);
     }
 
     template <class T2>
-    T2 finishReturnMemoryReduction(reductionType type) const {
-      return functional::hostReduction<T2>(type, returnMemory);
+    void finishReduction(reductionType type,
+                         occa::memory partials,
+                         const int reductionCount,
+                         occa::memory output) const {
+      occa::scope scope = getFinishReductionScope<T2>(type, partials, reductionCount, output);
+
+      if (usingNativeCpuMode()) {
+        OCCA_JIT(scope, (
+          for (int outerIndex = 0; outerIndex < 1; ++outerIndex; @outer) {
+            for (int innerIndex = 0; innerIndex < 1; ++innerIndex; @inner) {
+              T2 acc = occa_array_return[0];
+              for (int i = 1; i < occa_array_reduction_count; ++i) {
+                const T2 leftValue = acc;
+                const T2 rightValue = occa_array_return[i];
+                acc = OCCA_ARRAY_LOCAL_REDUCTION(leftValue, rightValue);
+              }
+              occa_array_output[0] = acc;
+            }
+          }
+        ));
+        return;
+      }
+
+      OCCA_JIT(scope, (
+        for (int outerIndex = 0; outerIndex < 1; ++outerIndex; @outer) {
+          @shared volatile T2 tileAcc[OCCA_ARRAY_TILE_SIZE];
+
+          // Partials past occa_array_reduction_count are never read
+          for (int localIndex = 0; localIndex < OCCA_ARRAY_TILE_SIZE; ++localIndex; @inner) {
+            if (localIndex < occa_array_reduction_count) {
+              T2 localAcc = occa_array_return[localIndex];
+              for (int i = localIndex + OCCA_ARRAY_TILE_SIZE; i < occa_array_reduction_count; i += OCCA_ARRAY_TILE_SIZE) {
+                const T2 leftValue = localAcc;
+                const T2 rightValue = occa_array_return[i];
+                localAcc = OCCA_ARRAY_LOCAL_REDUCTION(leftValue, rightValue);
+              }
+              tileAcc[localIndex] = localAcc;
+            }
+          }
+
+          OCCA_ARRAY_PARTIAL_REDUCTION(128)
+          OCCA_ARRAY_PARTIAL_REDUCTION(64)
+          OCCA_ARRAY_PARTIAL_REDUCTION(32)
+          OCCA_ARRAY_PARTIAL_REDUCTION(16)
+          OCCA_ARRAY_PARTIAL_REDUCTION(8)
+          OCCA_ARRAY_PARTIAL_REDUCTION(4)
+          OCCA_ARRAY_PARTIAL_REDUCTION(2)
+          OCCA_ARRAY_PARTIAL_REDUCTION(1)
+
+          for (int i = 0; i < OCCA_ARRAY_TILE_SIZE; ++i; @inner) {
+            if (i == 0) {
+              occa_array_output[0] = tileAcc[0];
+            }
+          }
+        }
+      ));
     }
     //==================================
   };
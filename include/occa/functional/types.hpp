@@ -13,6 +13,12 @@ namespace occa {
     min,
     max
   };
+
+  namespace hostAccess {
+    static const int read      = (1 << 0);
+    static const int write     = (1 << 1);
+    static const int readWrite = (read | write);
+  }
 }
 
 #endif
@@ -0,0 +1,12 @@
+#ifndef OCCA_KERNELPRELUDE_HEADER
+#define OCCA_KERNELPRELUDE_HEADER
+
+// Only the parts of OCCA used by generated Serial and OpenMP kernels,
+//   keeping the host API out of every kernel compilation
+#include <occa/defines.hpp>
+#include <occa/types/typedefs.hpp>
+#include <occa/types/tuples.hpp>
+#include <occa/core/hostAtomics.hpp>
+#include <occa/core/packedArgs.hpp>
+
+#endif
@@ -1,6 +1,7 @@
 #include <occa/core/device.hpp>
 #include <occa/core/base.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/core/graph.hpp>
 #include <occa/internal/core/kernel.hpp>
 #include <occa/internal/core/memory.hpp>
 #include <occa/internal/modes.hpp>
@@ -49,6 +50,13 @@ namespace occa {
   }
   //====================================
 
+  kernelBuildInfo::kernelBuildInfo(const std::string &filename_,
+                                   const std::string &kernelName_,
+                                   const occa::json &props_) :
+    filename(filename_),
+    kernelName(kernelName_),
+    props(props_) {}
+
   device::device() :
     modeDevice(NULL) {}
 
@@ -251,6 +259,43 @@ namespace occa {
     }
   }
 
+  occa::json device::kernelCacheStats() const {
+    occa::json stats;
+    if (modeDevice) {
+      stats["hits"] = modeDevice->kernelCacheHits;
+      stats["misses"] = modeDevice->kernelCacheMisses;
+      stats["size"] = (udim_t) modeDevice->cachedKernels.size();
+      stats["capacity"] = modeDevice->kernelCacheSize;
+    }
+    return stats;
+  }
+
+  occa::json device::buildStats() const {
+    if (modeDevice) {
+      return modeDevice->buildStats;
+    }
+    return occa::json();
+  }
+
+  occa::json device::memoryPoolStats() const {
+    if (modeDevice) {
+      return modeDevice->memoryPool.getStats();
+    }
+    return occa::json();
+  }
+
+  void device::trimMemoryPool() {
+    if (modeDevice) {
+      modeDevice->memoryPool.trim();
+    }
+  }
+
+  void device::clearKernelCache() {
+    if (modeDevice) {
+      modeDevice->clearCachedKernels();
+    }
+  }
+
   bool device::hasSeparateMemorySpace() {
     return (modeDevice &&
             modeDevice->hasSeparateMemorySpace());
@@ -296,6 +341,32 @@ namespace occa {
   }
   //  |=================================
 
+  //  |---[ Graph ]---------------------
+  void device::beginCapture() {
+    assertInitialized();
+    OCCA_ERROR("Device is already capturing a graph",
+               modeDevice->capturingGraph == NULL);
+
+    modeDevice->capturingGraph = modeDevice->createGraph();
+  }
+
+  graph device::endCapture() {
+    assertInitialized();
+    OCCA_ERROR("Device is not capturing a graph",
+               modeDevice->capturingGraph != NULL);
+
+    modeGraph_t *modeGraph = modeDevice->capturingGraph;
+    modeDevice->capturingGraph = NULL;
+    modeGraph->finalize();
+
+    return graph(modeGraph);
+  }
+
+  bool device::isCapturing() const {
+    return (modeDevice && (modeDevice->capturingGraph != NULL));
+  }
+  //  |=================================
+
   //  |---[ Kernel ]--------------------
   void device::setupKernelInfo(const occa::json &props,
                                const hash_t &sourceHash,
@@ -363,33 +434,30 @@ namespace occa {
   kernel device::buildKernel(const std::string &filename,
                              const std::string &kernelName,
                              const occa::json &props) const {
-    occa::json allProps;
-    hash_t kernelHash;
+    assertInitialized();
+
     const std::string realFilename = io::findInPaths(filename, env::OCCA_KERNEL_PATH);
-    setupKernelInfo(props, hashFile(realFilename),
-                    allProps, kernelHash);
 
-    // TODO: [#185] Fix kernel cache frees
-    // // Check cache first
-    // kernel &cachedKernel = modeDevice->getCachedKernel(kernelHash,
-    //                                                    kernelName);
-    // if (cachedKernel.isInitialized()) {
-    //   return cachedKernel;
-    // }
+    // Check the in-process cache before hashing the source and its dependencies
+    const std::string cacheKey = getKernelCacheKey(realFilename, kernelName, props);
+    kernel cachedKernel = modeDevice->getCachedKernel(cacheKey);
+    if (cachedKernel.isInitialized()) {
+      return cachedKernel;
+    }
 
-    const std::string hashDir = io::hashDir(realFilename, kernelHash);
-    allProps["hash"] = kernelHash.getFullString();
+    const double startTime = sys::currentTime();
 
-    kernel cachedKernel = modeDevice->buildKernel(realFilename,
-                                                  kernelName,
-                                                  kernelHash,
-                                                  allProps);
+    occa::json allProps;
+    hash_t kernelHash;
+    setupKernelInfo(props, hashFile(realFilename),
+                    allProps, kernelHash);
 
-    if (cachedKernel.isInitialized()) {
-      cachedKernel.modeKernel->hash = kernelHash;
-    } else {
-      sys::rmrf(hashDir);
-    }
+    cachedKernel = buildUncachedKernel(realFilename,
+                                       kernelName,
+                                       kernelHash,
+                                       allProps);
+    modeDevice->setCachedKernel(cacheKey, cachedKernel);
+    modeDevice->addBuildTime(sys::currentTime() - startTime);
 
     return cachedKernel;
   }
@@ -397,9 +465,24 @@ namespace occa {
   kernel device::buildKernelFromString(const std::string &content,
                                        const std::string &kernelName,
                                        const occa::json &props) const {
+    assertInitialized();
+
+    const hash_t contentHash = occa::hash(content);
+
+    const std::string cacheKey = modeDevice->getKernelHash(
+      contentHash ^ occa::hash(props),
+      kernelName
+    );
+    kernel cachedKernel = modeDevice->getCachedKernel(cacheKey);
+    if (cachedKernel.isInitialized()) {
+      return cachedKernel;
+    }
+
+    const double startTime = sys::currentTime();
+
     occa::json allProps;
     hash_t kernelHash;
-    setupKernelInfo(props, occa::hash(content),
+    setupKernelInfo(props, contentHash,
                     allProps, kernelHash);
 
     std::string stringSourceFile = (
@@ -416,9 +499,141 @@ namespace occa {
       }
     );
 
-    return buildKernel(stringSourceFile,
-                       kernelName,
-                       props);
+    cachedKernel = buildUncachedKernel(stringSourceFile,
+                                       kernelName,
+                                       kernelHash,
+                                       allProps);
+    modeDevice->setCachedKernel(cacheKey, cachedKernel);
+    modeDevice->addBuildTime(sys::currentTime() - startTime);
+
+    return cachedKernel;
+  }
+
+  std::vector<kernel> device::buildKernels(const std::vector<kernelBuildInfo> &kernels) const {
+    assertInitialized();
+
+    const double startTime = sys::currentTime();
+
+    const int kernelCount = (int) kernels.size();
+    std::vector<kernel> builtKernels(kernelCount);
+
+    // Requests that need to be built, along with the kernels they map to
+    std::vector<kernelBuildRequest_t> requests;
+    std::vector<std::string> requestCacheKeys;
+    std::vector<int> kernelRequests(kernelCount, -1);
+    std::map<std::string, int> cacheKeyRequests;
+
+    for (int i = 0; i < kernelCount; ++i) {
+      const kernelBuildInfo &info = kernels[i];
+      const std::string realFilename = io::findInPaths(info.filename, env::OCCA_KERNEL_PATH);
+
+      const std::string cacheKey = getKernelCacheKey(realFilename, info.kernelName, info.props);
+
+      std::map<std::string, int>::iterator it = cacheKeyRequests.find(cacheKey);
+      if (it != cacheKeyRequests.end()) {
+        kernelRequests[i] = it->second;
+        continue;
+      }
+
+      builtKernels[i] = modeDevice->getCachedKernel(cacheKey);
+      if (builtKernels[i].isInitialized()) {
+        continue;
+      }
+
+      occa::json allProps;
+      hash_t kernelHash;
+      setupKernelInfo(info.props, hashFile(realFilename),
+                      allProps, kernelHash);
+      allProps["hash"] = kernelHash.getFullString();
+
+      kernelRequests[i] = (int) requests.size();
+      cacheKeyRequests[cacheKey] = kernelRequests[i];
+      requests.push_back(
+        kernelBuildRequest_t(realFilename, info.kernelName, kernelHash, allProps)
+      );
+      requestCacheKeys.push_back(cacheKey);
+    }
+
+    if (requests.size()) {
+      modeDevice->buildKernels(requests, sys::defaultJobCount());
+    }
+
+    const int requestCount = (int) requests.size();
+    std::vector<kernel> requestKernels(requestCount);
+    for (int i = 0; i < requestCount; ++i) {
+      kernelBuildRequest_t &request = requests[i];
+
+      requestKernels[i] = kernel(request.modeKernel);
+      if (requestKernels[i].isInitialized()) {
+        request.modeKernel->hash = request.kernelHash;
+        modeDevice->setCachedKernel(requestCacheKeys[i], requestKernels[i]);
+        modeDevice->addBuildStats(request.modeKernel);
+      } else {
+        sys::rmrf(io::hashDir(request.filename, request.kernelHash));
+      }
+    }
+
+    // The first kernel sharing a request gets the built kernel, the rest get clones
+    std::vector<bool> requestKernelUsed(requestCount, false);
+    for (int i = 0; i < kernelCount; ++i) {
+      const int requestIndex = kernelRequests[i];
+      if (requestIndex < 0) {
+        continue;
+      }
+      kernel &requestKernel = requestKernels[requestIndex];
+      if (!requestKernelUsed[requestIndex] || !requestKernel.isInitialized()) {
+        builtKernels[i] = requestKernel;
+        requestKernelUsed[requestIndex] = true;
+        continue;
+      }
+      builtKernels[i] = kernel(requestKernel.getModeKernel()->clone());
+      if (!builtKernels[i].isInitialized()) {
+        builtKernels[i] = requestKernel;
+      }
+    }
+
+    if (requestCount) {
+      modeDevice->addBuildTime(sys::currentTime() - startTime);
+    }
+
+    return builtKernels;
+  }
+
+  std::string device::getKernelCacheKey(const std::string &realFilename,
+                                        const std::string &kernelName,
+                                        const occa::json &props) const {
+    // The file's size and modification time make edits invalidate cached kernels
+    const std::string fileStamp = (
+      realFilename
+      + ':' + toString(io::fileSize(realFilename))
+      + ':' + toString(io::fileModifiedTime(realFilename))
+    );
+    return modeDevice->getKernelHash(
+      occa::hash(fileStamp) ^ occa::hash(props),
+      kernelName
+    );
+  }
+
+  kernel device::buildUncachedKernel(const std::string &realFilename,
+                                     const std::string &kernelName,
+                                     const hash_t &kernelHash,
+                                     occa::json &allProps) const {
+    const std::string hashDir = io::hashDir(realFilename, kernelHash);
+    allProps["hash"] = kernelHash.getFullString();
+
+    kernel builtKernel = modeDevice->buildKernel(realFilename,
+                                                 kernelName,
+                                                 kernelHash,
+                                                 allProps);
+
+    if (builtKernel.isInitialized()) {
+      builtKernel.modeKernel->hash = kernelHash;
+      modeDevice->addBuildStats(builtKernel.modeKernel);
+    } else {
+      sys::rmrf(hashDir);
+    }
+
+    return builtKernel;
   }
 
   kernel device::buildKernelFromBinary(const std::string &filename,
@@ -449,6 +664,17 @@ namespace occa {
 
     occa::json memProps = memoryProperties(props);
 
+    // Wrapped host pointers are never pooled
+    const bool wrapsSrc = src && memProps.get("use_host_pointer", false);
+    if (!wrapsSrc && modeDevice->memoryPool.usePool(props)) {
+      memory mem(modeDevice->memoryPool.malloc(bytes, memProps));
+      mem.setDtype(dtype);
+      if (src) {
+        mem.copyFrom(src, bytes);
+      }
+      return mem;
+    }
+
     memory mem(modeDevice->malloc(bytes, src, memProps));
     mem.setDtype(dtype);
 
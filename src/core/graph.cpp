@@ -0,0 +1,112 @@
+#include <occa/core/graph.hpp>
+#include <occa/core/device.hpp>
+#include <occa/internal/core/device.hpp>
+#include <occa/internal/core/graph.hpp>
+
+namespace occa {
+  graph::graph() :
+    modeGraph(NULL) {}
+
+  graph::graph(modeGraph_t *modeGraph_) :
+    modeGraph(NULL) {
+    setModeGraph(modeGraph_);
+  }
+
+  graph::graph(const graph &g) :
+    modeGraph(NULL) {
+    setModeGraph(g.modeGraph);
+  }
+
+  graph& graph::operator = (const graph &g) {
+    setModeGraph(g.modeGraph);
+    return *this;
+  }
+
+  graph::~graph() {
+    removeGraphRef();
+  }
+
+  void graph::assertInitialized() const {
+    OCCA_ERROR("Graph not initialized or has been freed",
+               modeGraph != NULL);
+  }
+
+  void graph::setModeGraph(modeGraph_t *modeGraph_) {
+    if (modeGraph != modeGraph_) {
+      removeGraphRef();
+      modeGraph = modeGraph_;
+      if (modeGraph) {
+        modeGraph->addGraphRef(this);
+      }
+    }
+  }
+
+  void graph::removeGraphRef() {
+    if (!modeGraph) {
+      return;
+    }
+    modeGraph->removeGraphRef(this);
+    if (modeGraph->modeGraph_t::needsFree()) {
+      free();
+    }
+  }
+
+  void graph::dontUseRefs() {
+    if (modeGraph) {
+      modeGraph->modeGraph_t::dontUseRefs();
+    }
+  }
+
+  bool graph::isInitialized() const {
+    return (modeGraph != NULL);
+  }
+
+  modeGraph_t* graph::getModeGraph() const {
+    return modeGraph;
+  }
+
+  modeDevice_t* graph::getModeDevice() const {
+    return modeGraph->modeDevice;
+  }
+
+  occa::device graph::getDevice() const {
+    return occa::device(modeGraph
+                        ? modeGraph->modeDevice
+                        : NULL);
+  }
+
+  const std::string& graph::mode() const {
+    static const std::string noMode = "No Mode";
+    return (modeGraph
+            ? modeGraph->modeDevice->mode
+            : noMode);
+  }
+
+  int graph::size() const {
+    return (modeGraph
+            ? (int) modeGraph->nodes.size()
+            : 0);
+  }
+
+  bool graph::operator == (const occa::graph &other) const {
+    return (modeGraph == other.modeGraph);
+  }
+
+  bool graph::operator != (const occa::graph &other) const {
+    return (modeGraph != other.modeGraph);
+  }
+
+  void graph::launch() const {
+    assertInitialized();
+    OCCA_ERROR("Graphs can't be launched while they are being captured",
+               !modeGraph->isCapturing);
+
+    modeGraph->launch();
+  }
+
+  void graph::free() {
+    // ~modeGraph_t NULLs all wrappers
+    delete modeGraph;
+    modeGraph = NULL;
+  }
+}
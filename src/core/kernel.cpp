@@ -3,6 +3,7 @@
 #include <occa/core/memory.hpp>
 #include <occa/internal/io.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/core/graph.hpp>
 #include <occa/internal/core/kernel.hpp>
 #include <occa/internal/lang/builtins/types.hpp>
 #include <occa/internal/lang/parser.hpp>
@@ -176,6 +177,14 @@ namespace occa {
     }
 
     modeKernel->setupRun();
+
+    // Arguments are validated once when they're recorded
+    modeGraph_t *capturingGraph = modeKernel->modeDevice->capturingGraph;
+    if (capturingGraph) {
+      capturingGraph->addKernelNode(modeKernel);
+      return;
+    }
+
     modeKernel->run();
   }
 
@@ -2,6 +2,7 @@
 #include <occa/core/memory.hpp>
 #include <occa/core/device.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/core/graph.hpp>
 #include <occa/internal/core/memory.hpp>
 #include <occa/internal/utils/sys.hpp>
 
@@ -203,6 +204,12 @@ namespace occa {
                << " trying to access [" << offset << ", " << (offset + bytes_) << "]",
                (bytes_ + offset) <= modeMemory->size);
 
+    modeGraph_t *capturingGraph = modeMemory->getModeDevice()->capturingGraph;
+    if (capturingGraph) {
+      capturingGraph->addCopyNode(modeMemory, src, bytes_, offset, props);
+      return;
+    }
+
     modeMemory->copyFrom(src, bytes_, offset, props);
   }
 
@@ -232,6 +239,12 @@ namespace occa {
                << " trying to access [" << destOffset << ", " << (destOffset + bytes_) << "]",
                (bytes_ + destOffset) <= modeMemory->size);
 
+    modeGraph_t *capturingGraph = modeMemory->getModeDevice()->capturingGraph;
+    if (capturingGraph) {
+      capturingGraph->addCopyNode(modeMemory, src.modeMemory, bytes_, destOffset, srcOffset, props);
+      return;
+    }
+
     modeMemory->copyFrom(src.modeMemory, bytes_, destOffset, srcOffset, props);
   }
 
@@ -253,6 +266,12 @@ namespace occa {
                << " trying to access [" << offset << ", " << (offset + bytes_) << "]",
                (bytes_ + offset) <= modeMemory->size);
 
+    modeGraph_t *capturingGraph = modeMemory->getModeDevice()->capturingGraph;
+    if (capturingGraph) {
+      capturingGraph->addCopyNode(dest, modeMemory, bytes_, offset, props);
+      return;
+    }
+
     modeMemory->copyTo(dest, bytes_, offset, props);
   }
 
@@ -282,6 +301,12 @@ namespace occa {
                << " trying to access [" << destOffset << ", " << (destOffset + bytes_) << "]",
                (bytes_ + destOffset) <= dest.modeMemory->size);
 
+    modeGraph_t *capturingGraph = dest.modeMemory->getModeDevice()->capturingGraph;
+    if (capturingGraph) {
+      capturingGraph->addCopyNode(dest.modeMemory, modeMemory, bytes_, destOffset, srcOffset, props);
+      return;
+    }
+
     dest.modeMemory->copyFrom(modeMemory, bytes_, destOffset, srcOffset, props);
   }
 
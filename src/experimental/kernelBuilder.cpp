@@ -8,6 +8,42 @@
 #include <occa/functional/scope.hpp>
 
 namespace occa {
+  bool kernelLaunchPlan::matches(const occa::scope &scope) const {
+    const scopeKernelArgVector &scopeArgs = scope.getArgs();
+    const int argCount = (int) argIndices.size();
+    const int scopeArgCount = (int) scopeArgs.size();
+    for (int i = 0; i < argCount; ++i) {
+      const int argIndex = argIndices[i];
+      if ((scopeArgCount <= argIndex) ||
+          (scopeArgs[argIndex].name != argNames[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void kernelLaunchPlan::setArgIndices(const occa::scope &scope) {
+    const lang::kernelMetadata_t &metadata = kernel.getModeKernel()->getMetadata();
+
+    const scopeKernelArgVector &scopeArgs = scope.getArgs();
+    const int scopeArgCount = (int) scopeArgs.size();
+
+    argIndices.clear();
+    argNames.clear();
+    for (const lang::argMetadata_t &arg : metadata.arguments) {
+      int argIndex = 0;
+      while ((argIndex < scopeArgCount) &&
+             (scopeArgs[argIndex].name != arg.name)) {
+        ++argIndex;
+      }
+      OCCA_ERROR("Missing argument [" << arg.name << "]",
+                 argIndex < scopeArgCount);
+
+      argIndices.push_back(argIndex);
+      argNames.push_back(arg.name);
+    }
+  }
+
   kernelBuilder::kernelBuilder(const std::string &source_,
                                const std::string &kernelName_) :
     source(strip(source_)),
@@ -38,44 +74,49 @@ namespace occa {
   }
 
   occa::kernel kernelBuilder::getOrBuildKernel(const occa::scope &scope) {
+    return getOrBuildLaunchPlan(scope).kernel;
+  }
+
+  kernelLaunchPlan& kernelBuilder::getOrBuildLaunchPlan(const occa::scope &scope) {
     occa::device device = scope.getDevice();
     const hash_t hash = (
       occa::hash(device) ^ occa::hash(scope)
     );
 
-    occa::kernel &kernel = kernelMap[hash];
-    if (!kernel.isInitialized()) {
-      kernel = device.buildKernelFromString(
+    kernelLaunchPlan &plan = launchPlans[hash];
+    if (!plan.kernel.isInitialized()) {
+      plan.kernel = device.buildKernelFromString(
         buildKernelSource(scope),
         kernelName,
-        scope.props
+        scope.getProps()
       );
+      plan.setArgIndices(scope);
     }
-    return kernel;
+    return plan;
   }
 
   void kernelBuilder::run(const occa::scope &scope) {
-    occa::kernel kernel = getOrBuildKernel(scope);
+    kernelLaunchPlan &plan = getOrBuildLaunchPlan(scope);
 
-    // Get argument metadata
-    const lang::kernelMetadata_t &metadata = kernel.getModeKernel()->getMetadata();
-    const std::vector<lang::argMetadata_t> &arguments = metadata.arguments;
+    // Scopes with the same signature can list their arguments in a different order
+    if (!plan.matches(scope)) {
+      plan.setArgIndices(scope);
+    }
 
-    // Insert arguments in the proper order
+    const scopeKernelArgVector &scopeArgs = scope.getArgs();
+    occa::kernel &kernel = plan.kernel;
     kernel.clearArgs();
-    for (const lang::argMetadata_t &arg : arguments) {
-      kernel.pushArg(scope.getArg(arg.name));
+    for (const int argIndex : plan.argIndices) {
+      kernel.pushArg(scopeArgs[argIndex]);
     }
 
     kernel.run();
   }
 
   void kernelBuilder::free() {
-    hashedKernelMapIterator it = kernelMap.begin();
-    while (it != kernelMap.end()) {
-      it->second.free();
-      ++it;
+    for (auto &it : launchPlans) {
+      it.second.kernel.free();
     }
-    kernelMap.clear();
+    launchPlans.clear();
   }
 }
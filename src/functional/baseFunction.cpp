@@ -39,7 +39,7 @@ namespace occa {
     }
 
     // Add the scope-injected arguments
-    for (const scopeKernelArg &arg : scope.args) {
+    for (const scopeKernelArg &arg : scope.getArgs()) {
       if (!isFirst) {
         call += ", ";
       }
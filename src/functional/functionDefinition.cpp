@@ -11,7 +11,7 @@ namespace occa {
   }
 
   int functionDefinition::totalArgumentCount() const {
-    return (int) (argTypes.size() + scope.args.size());
+    return (int) (argTypes.size() + scope.getArgs().size());
   }
 
   std::string functionDefinition::getFunctionSource(const std::string &functionName) {
@@ -23,7 +23,7 @@ namespace occa {
        << argumentSource;
 
     // Add captured variables at the end
-    if (scope.args.size()) {
+    if (scope.getArgs().size()) {
       if (argTypes.size()) {
         ss << ", ";
       }
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <sstream>
+
+#include <occa/functional/ndarray.hpp>
+
+namespace occa {
+  typelessNdarray::typelessNdarray() :
+    offset_(0) {}
+
+  typelessNdarray::typelessNdarray(const typelessNdarray &other) :
+    device_(other.device_),
+    dtype_(other.dtype_),
+    memory_(other.memory_),
+    offset_(other.offset_),
+    shape_(other.shape_),
+    strides_(other.strides_) {}
+
+  typelessNdarray& typelessNdarray::operator = (const typelessNdarray &other) {
+    device_ = other.device_;
+    dtype_ = other.dtype_;
+    memory_ = other.memory_;
+    offset_ = other.offset_;
+    shape_ = other.shape_;
+    strides_ = other.strides_;
+
+    return *this;
+  }
+
+  void typelessNdarray::setupTypelessNdarray(occa::device device__,
+                                             const dtype_t &dtype__,
+                                             const dimVector &shape,
+                                             const ndarrayLayout layout,
+                                             const int alignment) {
+    const dimVector strides = getStrides(shape, layout, alignment);
+
+    const int dimCount = (int) shape.size();
+    dim_t entries = 1;
+    for (int dim = 0; dim < dimCount; ++dim) {
+      entries = std::max(entries, strides[dim] * shape[dim]);
+    }
+
+    occa::memory mem = device__.malloc(entries, dtype__);
+    setupTypelessNdarray(mem, shape, layout, alignment);
+  }
+
+  void typelessNdarray::setupTypelessNdarray(occa::memory mem,
+                                             const dimVector &shape,
+                                             const ndarrayLayout layout,
+                                             const int alignment) {
+    device_ = mem.getDevice();
+    dtype_ = mem.dtype();
+    memory_ = mem;
+    offset_ = 0;
+    shape_ = shape;
+    strides_ = getStrides(shape, layout, alignment);
+
+    OCCA_ERROR("Memory is smaller than the ndarray layout",
+               span() <= memory_.length());
+  }
+
+  dimVector typelessNdarray::getStrides(const dimVector &shape,
+                                        const ndarrayLayout layout,
+                                        const int alignment) {
+    OCCA_ERROR("Alignment must be positive",
+               alignment > 0);
+
+    const int dimCount = (int) shape.size();
+    for (int dim = 0; dim < dimCount; ++dim) {
+      OCCA_ERROR("Dimension " << dim << " has a negative size",
+                 shape[dim] >= 0);
+    }
+
+    dimVector strides(dimCount);
+    if (!dimCount) {
+      return strides;
+    }
+
+    // Dimensions from the smallest to the largest stride
+    intVector order(dimCount);
+    for (int i = 0; i < dimCount; ++i) {
+      order[i] = (
+        layout == ndarrayLayout::rowMajor
+        ? (dimCount - i - 1)
+        : i
+      );
+    }
+
+    dim_t stride = 1;
+    for (int i = 0; i < dimCount; ++i) {
+      const int dim = order[i];
+      strides[dim] = stride;
+
+      // Only the leading dimension is padded
+      const dim_t extent = (
+        i == 0
+        ? alignment * ((shape[dim] + alignment - 1) / alignment)
+        : shape[dim]
+      );
+      stride *= std::max((dim_t) 1, extent);
+    }
+
+    return strides;
+  }
+
+  void typelessNdarray::typelessSlice(const int dim,
+                                      const dim_t start,
+                                      const dim_t count,
+                                      const dim_t step) {
+    OCCA_ERROR("Dimension " << dim << " is out of bounds",
+               (0 <= dim) && (dim < dims()));
+    OCCA_ERROR("Slice step must be positive",
+               step > 0);
+    OCCA_ERROR("Slice start is out of bounds",
+               (0 <= start) && (start <= shape_[dim]));
+
+    const dim_t maxCount = (shape_[dim] - start + step - 1) / step;
+    const dim_t safeCount = count < 0 ? maxCount : count;
+    OCCA_ERROR("Slice count is out of bounds",
+               safeCount <= maxCount);
+
+    offset_ += start * strides_[dim];
+    shape_[dim] = safeCount;
+    strides_[dim] *= step;
+  }
+
+  void typelessNdarray::typelessTranspose(const int dim1,
+                                          const int dim2) {
+    OCCA_ERROR("Dimensions are out of bounds",
+               (0 <= dim1) && (dim1 < dims()) && (0 <= dim2) && (dim2 < dims()));
+
+    std::swap(shape_[dim1], shape_[dim2]);
+    std::swap(strides_[dim1], strides_[dim2]);
+  }
+
+  void typelessNdarray::assertSameShape(const typelessNdarray &other) const {
+    OCCA_ERROR("Expected ndarrays with the same shape",
+               shape_ == other.shape_);
+  }
+
+  intVector typelessNdarray::getLoopOrder() const {
+    const int dimCount = dims();
+
+    intVector order(dimCount);
+    for (int dim = 0; dim < dimCount; ++dim) {
+      order[dim] = dim;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](const int dim1, const int dim2) {
+      return strides_[dim1] > strides_[dim2];
+    });
+
+    return order;
+  }
+
+  void typelessNdarray::typelessMapTo(const typelessNdarray &output,
+                                      const std::string &functionCall,
+                                      const occa::scope &functionScope) const {
+    const int dimCount = dims();
+
+    auto shapeName = [&](const int dim) {
+      return "occa_ndarray_shape_" + std::to_string(dim);
+    };
+    auto indexName = [&](const int dim) {
+      return "occa_ndarray_i" + std::to_string(dim);
+    };
+
+    // Loop over the output with its smallest stride in the @inner loop
+    // At most 3 @outer loops are available, leading dimensions are flattened
+    //   into a single @outer loop if needed
+    const intVector order = output.getLoopOrder();
+    const int innerDim = order[dimCount - 1];
+    const int flattenedDimCount = std::max(0, dimCount - 2);
+
+    std::stringstream loopsStart, loopsEnd;
+    int outerCount = 1;
+    if (dimCount > 3) {
+      loopsStart << "for (int occa_ndarray_outer = 0;"
+                 << " occa_ndarray_outer < occa_ndarray_outer_count;"
+                 << " ++occa_ndarray_outer; @outer) {";
+      loopsEnd << '}';
+
+      for (int i = 0; i < flattenedDimCount; ++i) {
+        std::string divisor = "1";
+        for (int j = i + 1; j < flattenedDimCount; ++j) {
+          divisor += " * " + shapeName(order[j]);
+        }
+        loopsStart << "const int " << indexName(order[i]) << " = ("
+                   << "(occa_ndarray_outer / (" << divisor << "))"
+                   << " % " << shapeName(order[i]) << ");";
+        outerCount *= (int) output.shape_[order[i]];
+      }
+    }
+    for (int i = (dimCount > 3 ? flattenedDimCount : 0); i < (dimCount - 1); ++i) {
+      const std::string index = indexName(order[i]);
+      loopsStart << "for (int " << index << " = 0;"
+                 << ' ' << index << " < " << shapeName(order[i]) << ';'
+                 << " ++" << index << "; @outer) {";
+      loopsEnd << '}';
+    }
+    {
+      const std::string index = indexName(innerDim);
+      loopsStart << "for (int " << index << " = 0;"
+                 << ' ' << index << " < " << shapeName(innerDim) << ';'
+                 << " ++" << index << "; @tile(OCCA_NDARRAY_TILE_SIZE, @outer, @inner)) {";
+      loopsEnd << '}';
+    }
+
+    std::string inputIndex = "0";
+    std::string outputIndex = "0";
+    std::string rowMajorIndex = "0";
+    for (int dim = 0; dim < dimCount; ++dim) {
+      const std::string index = indexName(dim);
+      const std::string dimStr = std::to_string(dim);
+      inputIndex += " + (" + index + " * occa_ndarray_input_stride_" + dimStr + ")";
+      outputIndex += " + (" + index + " * occa_ndarray_output_stride_" + dimStr + ")";
+      rowMajorIndex = "((" + rowMajorIndex + ") * " + shapeName(dim) + " + " + index + ")";
+    }
+
+    occa::scope scope({}, {
+      {"defines/T", dtype_.name()},
+      {"defines/OCCA_NDARRAY_TILE_SIZE", 128},
+      {"defines/OCCA_NDARRAY_LOOPS_START", loopsStart.str()},
+      {"defines/OCCA_NDARRAY_LOOPS_END", loopsEnd.str()},
+      {"defines/OCCA_NDARRAY_INPUT_INDEX", "(" + inputIndex + ")"},
+      {"defines/OCCA_NDARRAY_OUTPUT_INDEX", "(" + outputIndex + ")"},
+      {"defines/OCCA_NDARRAY_ROW_MAJOR_INDEX", rowMajorIndex},
+      {"defines/OCCA_NDARRAY_FUNCTION(VALUE, INDEX)", functionCall}
+    });
+    scope.device = device_;
+
+    const occa::memory input = dataMemory();
+    occa::memory outputMemory = output.dataMemory();
+    scope.add("occa_ndarray_input", input);
+    scope.add("occa_ndarray_output", outputMemory);
+    for (int dim = 0; dim < dimCount; ++dim) {
+      const std::string dimStr = std::to_string(dim);
+      scope.add(shapeName(dim), (int) shape_[dim]);
+      scope.add("occa_ndarray_input_stride_" + dimStr, (int) strides_[dim]);
+      scope.add("occa_ndarray_output_stride_" + dimStr, (int) output.strides_[dim]);
+    }
+    if (dimCount > 3) {
+      scope.add("occa_ndarray_outer_count", outerCount);
+    }
+    scope += functionScope;
+
+    OCCA_JIT(scope, (
+      OCCA_NDARRAY_LOOPS_START
+        occa_ndarray_output[OCCA_NDARRAY_OUTPUT_INDEX] = OCCA_NDARRAY_FUNCTION(
+          occa_ndarray_input[OCCA_NDARRAY_INPUT_INDEX],
+          OCCA_NDARRAY_ROW_MAJOR_INDEX
+        );
+      OCCA_NDARRAY_LOOPS_END
+    ));
+  }
+
+  occa::device typelessNdarray::getDevice() const {
+    return device_;
+  }
+
+  occa::dtype_t typelessNdarray::dtype() const {
+    return dtype_;
+  }
+
+  int typelessNdarray::dims() const {
+    return (int) shape_.size();
+  }
+
+  dim_t typelessNdarray::shape(const int dim) const {
+    return shape_[dim];
+  }
+
+  const dimVector& typelessNdarray::shape() const {
+    return shape_;
+  }
+
+  dim_t typelessNdarray::stride(const int dim) const {
+    return strides_[dim];
+  }
+
+  const dimVector& typelessNdarray::strides() const {
+    return strides_;
+  }
+
+  dim_t typelessNdarray::offset() const {
+    return offset_;
+  }
+
+  udim_t typelessNdarray::size() const {
+    if (!dims()) {
+      return 0;
+    }
+    udim_t entries = 1;
+    for (const dim_t dimSize : shape_) {
+      entries *= dimSize;
+    }
+    return entries;
+  }
+
+  udim_t typelessNdarray::span() const {
+    if (!size()) {
+      return 0;
+    }
+    udim_t entries = 1;
+    const int dimCount = dims();
+    for (int dim = 0; dim < dimCount; ++dim) {
+      entries += (shape_[dim] - 1) * strides_[dim];
+    }
+    return entries;
+  }
+
+  bool typelessNdarray::isContiguous() const {
+    return span() == size();
+  }
+
+  bool typelessNdarray::isRowMajor() const {
+    const dimVector rowMajorStrides = getStrides(shape_, ndarrayLayout::rowMajor);
+
+    const int dimCount = dims();
+    for (int dim = 0; dim < dimCount; ++dim) {
+      // Strides of single-entry dimensions are never used
+      if ((shape_[dim] > 1) && (strides_[dim] != rowMajorStrides[dim])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  occa::memory typelessNdarray::dataMemory() const {
+    return memory_.slice(offset_, span());
+  }
+
+  typelessNdarray::operator kernelArg() const {
+    return dataMemory();
+  }
+
+  std::string typelessNdarray::dimAttributes() const {
+    const int dimCount = dims();
+
+    // Dimensions from the smallest to the largest stride with single-entry
+    //   dimensions last since their stride is never used
+    intVector order = getLoopOrder();
+    std::reverse(order.begin(), order.end());
+    std::stable_partition(order.begin(), order.end(), [&](const int dim) {
+      return shape_[dim] > 1;
+    });
+
+    dimVector extents(dimCount, 1);
+    dim_t expectedStride = 1;
+    for (int i = 0; i < dimCount; ++i) {
+      const int dim = order[i];
+      if (shape_[dim] <= 1) {
+        break;
+      }
+
+      OCCA_ERROR("The ndarray layout can't be indexed with @dim",
+                 strides_[dim] == expectedStride);
+
+      // The extent of the last dimension is never used
+      const bool isLast = ((i + 1) == dimCount) || (shape_[order[i + 1]] <= 1);
+      if (isLast) {
+        extents[dim] = shape_[dim];
+      } else {
+        const dim_t nextStride = strides_[order[i + 1]];
+        OCCA_ERROR("The ndarray layout can't be indexed with @dim",
+                   (nextStride % strides_[dim]) == 0);
+        extents[dim] = nextStride / strides_[dim];
+        expectedStride = nextStride;
+      }
+    }
+
+    std::stringstream ss;
+    ss << "@dim(";
+    for (int dim = 0; dim < dimCount; ++dim) {
+      if (dim) {
+        ss << ", ";
+      }
+      ss << extents[dim];
+    }
+    ss << ") @dimOrder(";
+    for (int i = 0; i < dimCount; ++i) {
+      if (i) {
+        ss << ", ";
+      }
+      ss << order[i];
+    }
+    ss << ')';
+
+    return ss.str();
+  }
+}
@@ -72,13 +72,13 @@ namespace occa {
     if (start) {
       scope.add("occa_range_start", start);
     } else {
-      scope.props["defines/occa_range_start"] = 0;
+      scope.setProp("defines/occa_range_start", 0);
     }
 
     if (step != 1 && step != -1) {
       scope.add("occa_range_step", step);
     } else {
-      scope.props["defines/occa_range_step"] = step;
+      scope.setProp("defines/occa_range_step", step);
     }
 
     scope.add("occa_range_end", end);
@@ -88,7 +88,8 @@ namespace occa {
     occa::scope scope;
 
     setupArrayScopeOverrides(scope);
-    scope.props["defines/OCCA_ARRAY_FUNCTION_CALL(INDEX)"] = (
+    scope.setProp(
+      "defines/OCCA_ARRAY_FUNCTION_CALL(INDEX)",
       "OCCA_ARRAY_FUNCTION(occa_range_start + (occa_range_step * INDEX), _, _)"
     );
 
@@ -99,7 +100,8 @@ namespace occa {
     occa::scope scope;
 
     setupArrayScopeOverrides(scope);
-    scope.props["defines/OCCA_ARRAY_FUNCTION_CALL(ACC, INDEX)"] = (
+    scope.setProp(
+      "defines/OCCA_ARRAY_FUNCTION_CALL(ACC, INDEX)",
       "OCCA_ARRAY_FUNCTION(ACC, occa_range_start + (occa_range_step * INDEX), _, _)"
     );
 
@@ -42,11 +42,24 @@ namespace occa {
     for (const scopeKernelArg &arg : other.args) {
       add(arg);
     }
-    props += other.props;
+    addProps(other.props);
 
     return *this;
   }
 
+  const occa::json& scope::getProps() const {
+    return props;
+  }
+
+  void scope::addProps(const occa::json &props_) {
+    props += props_;
+    hash_.clear();
+  }
+
+  const scopeKernelArgVector& scope::getArgs() const {
+    return args;
+  }
+
   occa::device scope::getDevice() const {
     return (
       device.isInitialized()
@@ -104,10 +117,17 @@ namespace occa {
   }
 
   hash_t scope::hash() const {
-    return (
-      occa::hash(props)
-      ^ occa::hash(args)
-    );
+    if (!hash_.isInitialized()) {
+      hash_ = (
+        occa::hash(props)
+        ^ occa::hash(args)
+      );
+    }
+    return hash_;
+  }
+
+  bool scope::hasCachedHash() const {
+    return hash_.isInitialized();
   }
 
   template <>
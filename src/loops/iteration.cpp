@@ -81,13 +81,13 @@ namespace occa {
     if (range.start) {
       scope.add(startName, range.start);
     } else {
-      scope.props["defines"][startName] = 0;
+      scope.setProp("defines/" + startName, 0);
     }
 
     if (range.step != 1 && range.step != -1) {
       scope.add(stepName, range.step);
     } else {
-      scope.props["defines"][stepName] = range.step;
+      scope.setProp("defines/" + stepName, range.step);
     }
 
     scope.add(endName, range.end);
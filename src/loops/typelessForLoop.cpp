@@ -40,7 +40,7 @@ namespace occa {
     // Inject the function information
     const functionDefinition &fnDefinition = fn.definition();
 
-    loopScope.props["defines/OCCA_LOOP_FUNCTION"] = fnDefinition.bodySource;
+    loopScope.setProp("defines/OCCA_LOOP_FUNCTION", fnDefinition.bodySource);
 
     // TODO: This is a hack, we should really be parsing the content
     //       and finding the argument names
@@ -49,7 +49,8 @@ namespace occa {
     const std::string outerIndexName = strip(
       split(arguments[0], ' ').back()
     );
-    loopScope.props["defines/OCCA_LOOP_OUTER_INDEX_NAME"] = (
+    loopScope.setProp(
+      "defines/OCCA_LOOP_OUTER_INDEX_NAME",
       outerIndexName.size()
       ? outerIndexName
       : "_loopOuterIndex"
@@ -59,7 +60,8 @@ namespace occa {
       const std::string innerIndexName = strip(
         split(arguments[1], ' ').back()
       );
-      loopScope.props["defines/OCCA_LOOP_INNER_INDEX_NAME"] = (
+      loopScope.setProp(
+        "defines/OCCA_LOOP_INNER_INDEX_NAME",
         innerIndexName.size()
         ? innerIndexName
         : "_loopInnerIndex"
@@ -72,10 +74,11 @@ namespace occa {
       outerForLoopsStart += buildOuterLoop(loopScope, i);
       outerForLoopsEnd += "}";
     }
-    loopScope.props["defines/OCCA_LOOP_START_OUTER_LOOPS"] = outerForLoopsStart;
-    loopScope.props["defines/OCCA_LOOP_END_OUTER_LOOPS"] = outerForLoopsEnd;
+    loopScope.setProp("defines/OCCA_LOOP_START_OUTER_LOOPS", outerForLoopsStart);
+    loopScope.setProp("defines/OCCA_LOOP_END_OUTER_LOOPS", outerForLoopsEnd);
 
-    loopScope.props["defines/OCCA_LOOP_INIT_OUTER_INDEX"] = (
+    loopScope.setProp(
+      "defines/OCCA_LOOP_INIT_OUTER_INDEX",
       buildIndexInitializer("OCCA_LOOP_OUTER_INDEX_NAME",
                             "OUTER_INDEX",
                             outerIterationCount)
@@ -88,19 +91,20 @@ namespace occa {
         innerForLoopsStart += buildInnerLoop(loopScope, i);
         innerForLoopsEnd += "}";
       }
-      loopScope.props["defines/OCCA_LOOP_START_INNER_LOOPS"] = innerForLoopsStart;
-      loopScope.props["defines/OCCA_LOOP_END_INNER_LOOPS"] = innerForLoopsEnd;
+      loopScope.setProp("defines/OCCA_LOOP_START_INNER_LOOPS", innerForLoopsStart);
+      loopScope.setProp("defines/OCCA_LOOP_END_INNER_LOOPS", innerForLoopsEnd);
 
-      loopScope.props["defines/OCCA_LOOP_INIT_INNER_INDEX"] = (
+      loopScope.setProp(
+        "defines/OCCA_LOOP_INIT_INNER_INDEX",
         buildIndexInitializer("OCCA_LOOP_INNER_INDEX_NAME",
                               "INNER_INDEX",
                               innerIterationCount)
       );
     } else {
       // Nothing to setup for @inner loops
-      loopScope.props["defines/OCCA_LOOP_START_INNER_LOOPS"] = "";
-      loopScope.props["defines/OCCA_LOOP_END_INNER_LOOPS"] = "";
-      loopScope.props["defines/OCCA_LOOP_INIT_INNER_INDEX"] = "";
+      loopScope.setProp("defines/OCCA_LOOP_START_INNER_LOOPS", "");
+      loopScope.setProp("defines/OCCA_LOOP_END_INNER_LOOPS", "");
+      loopScope.setProp("defines/OCCA_LOOP_INIT_INNER_INDEX", "");
     }
 
     return loopScope;
@@ -1,8 +1,10 @@
+#include <cstdlib>
 #include <fstream>
 
 #include <occa/core.hpp>
 
 #include <occa/internal/bin/occa.hpp>
+#include <occa/internal/utils/compileServer.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 #include <occa/internal/lang/modes/openmp.hpp>
@@ -236,6 +238,52 @@ namespace occa {
       return true;
     }
 
+    bool runCompileServer(const json &args) {
+      const json &options = args["options"];
+
+      std::string socketPath = options["socket"];
+      if (!socketPath.size()) {
+        socketPath = env::var("OCCA_COMPILE_SERVER");
+      }
+      if (!socketPath.size()) {
+        socketPath = env::OCCA_CACHE_DIR + "compile_server.sock";
+      }
+
+      if (options["stop"]) {
+        if (!compileServer::stop(socketPath)) {
+          printError("No compile server running on [" + socketPath + "]");
+          ::exit(1);
+        }
+        return true;
+      }
+
+      if (options["stats"]) {
+        json stats;
+        if (!compileServer::getStats(socketPath, stats)) {
+          printError("No compile server running on [" + socketPath + "]");
+          ::exit(1);
+        }
+        io::stdout << stats << '\n';
+        return true;
+      }
+
+      const std::string jobsStr = options["jobs"];
+      const int jobs = (
+        jobsStr.size()
+        ? std::max(1, std::atoi(jobsStr.c_str()))
+        : sys::defaultJobCount()
+      );
+
+      io::stdout << "Compile server listening on [" << socketPath << "]"
+                 << " with [" << jobs << "] jobs\n"
+                 << "  Set OCCA_COMPILE_SERVER=" << socketPath << " to use it\n";
+
+      if (!compileServer::serve(socketPath, jobs)) {
+        ::exit(1);
+      }
+      return true;
+    }
+
     bool runEnv(const json &args) {
       io::stdout << "  Basic:\n"
                  << "    - OCCA_DIR                   : " << envEcho("OCCA_DIR") << "\n"
@@ -268,6 +316,8 @@ namespace occa {
                  << "    - OCCA_LDFLAGS               : " << envEcho("OCCA_LDFLAGS") << "\n"
                  << "    - OCCA_COMPILER_SHARED_FLAGS : " << envEcho("OCCA_COMPILER_SHARED_FLAGS") << "\n"
                  << "    - OCCA_INCLUDE_PATH          : " << envEcho("OCCA_INCLUDE_PATH") << "\n"
+                 << "    - OCCA_COMPILE_SERVER        : " << envEcho("OCCA_COMPILE_SERVER") << "\n"
+                 << "    - OCCA_BUILD_STATS           : " << envEcho("OCCA_BUILD_STATS") << "\n"
                  << "    - OCCA_LIBRARY_PATH          : " << envEcho("OCCA_LIBRARY_PATH") << "\n"
                  << "    - OCCA_KERNEL_PATH           : " << envEcho("OCCA_KERNEL_PATH") << "\n"
                  << "    - OCCA_OPENCL_COMPILER_FLAGS : " << envEcho("OCCA_OPENCL_COMPILER_FLAGS") << "\n"
@@ -401,6 +451,24 @@ namespace occa {
                                      "Kernel name")
                        .isRequired());
 
+      cli::command compileServerCommand;
+      compileServerCommand
+          .withName("compile-server")
+          .withCallback(runCompileServer)
+          .withDescription("Run a node-local server which compiles Serial and OpenMP kernels"
+                           " once for all processes using it")
+          .addOption(cli::option('s', "socket",
+                                 "Unix socket to listen on"
+                                 " (Default: ${OCCA_COMPILE_SERVER} or ${OCCA_CACHE_DIR}/compile_server.sock)")
+                     .withArg())
+          .addOption(cli::option('j', "jobs",
+                                 "Number of concurrent compilations (Default: number of cores)")
+                     .withArg())
+          .addOption(cli::option("stats",
+                                 "Print stats from the running server"))
+          .addOption(cli::option("stop",
+                                 "Stop the running server"));
+
       cli::command envCommand;
       envCommand
           .withName("env")
@@ -441,6 +509,7 @@ namespace occa {
         .addCommand(clearCommand)
         .addCommand(translateCommand)
         .addCommand(compileCommand)
+        .addCommand(compileServerCommand)
         .addCommand(envCommand)
         .addCommand(infoCommand)
         .addCommand(modesCommand)
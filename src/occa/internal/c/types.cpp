@@ -355,7 +355,7 @@ namespace occa {
       return occa::kernel((occa::modeKernel_t*) value.value.ptr);
     }
 
-    occa::kernelBuilder kernelBuilder(occaType value) {
+    occa::kernelBuilder& kernelBuilder(occaType value) {
       OCCA_ERROR("Input is not an occaKernelBuilder",
                  value.type == typeType::kernelBuilder);
       return *((occa::kernelBuilder*) value.value.ptr);
@@ -921,7 +921,7 @@ void occaPrintTypeInfo(occaType value) {
         info["type"]  = "kernelBuilder";
         info["value"] = (void*) value.value.ptr;
 
-        occa::kernelBuilder kernelBuilder = occa::c::kernelBuilder(value);
+        occa::kernelBuilder &kernelBuilder = occa::c::kernelBuilder(value);
         if (kernelBuilder.isInitialized()) {
           info["kernel_name"] = kernelBuilder.getKernelName();
         } else {
@@ -985,10 +985,10 @@ void occaPrintTypeInfo(occaType value) {
 
         info["type"]  = "scope";
         info["value"] = (void*) value.value.ptr;
-        info["props"] = scope.props;
+        info["props"] = scope.getProps();
 
         occa::json args = info["args"].asArray();
-        for (auto &arg : scope.args) {
+        for (auto &arg : scope.getArgs()) {
           args += occa::json({
             {"name", arg.name},
             {"dtype", arg.dtype.toJson()},
@@ -114,7 +114,7 @@ namespace occa {
 
     occa::device device(occaType value);
     occa::kernel kernel(occaType value);
-    occa::kernelBuilder kernelBuilder(occaType value);
+    occa::kernelBuilder& kernelBuilder(occaType value);
     occa::memory memory(occaType value);
     occa::stream stream(occaType value);
     occa::streamTag streamTag(occaType value);
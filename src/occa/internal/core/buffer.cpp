@@ -11,7 +11,8 @@ namespace occa {
     ptr(NULL),
     modeDevice(modeDevice_),
     size(size_),
-    isWrapped(false) {
+    isWrapped(false),
+    memoryPool(NULL) {
     modeDevice->addMemoryRef(this);
   }
 
@@ -6,6 +6,7 @@
 #include <occa/internal/utils/gc.hpp>
 
 namespace occa {
+  class memoryPool_t;
   class modeMemory_t;
 
   class modeBuffer_t : public gc::ringEntry_t {
@@ -22,6 +23,9 @@ namespace occa {
 
     bool isWrapped;
 
+    // Set when the buffer is returned to a pool instead of being freed
+    memoryPool_t *memoryPool;
+
     modeBuffer_t(modeDevice_t *modeDevice_,
                  udim_t size_,
                  const occa::json &json_);
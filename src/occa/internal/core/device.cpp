@@ -1,19 +1,59 @@
+#include <algorithm>
+#include <fstream>
+
 #include <occa/internal/core/device.hpp>
 #include <occa/internal/core/kernel.hpp>
 #include <occa/internal/core/buffer.hpp>
+#include <occa/internal/core/graph.hpp>
 #include <occa/internal/core/memory.hpp>
 #include <occa/internal/core/stream.hpp>
 #include <occa/internal/core/streamTag.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/internal/utils/sys.hpp>
 
 namespace occa {
+  namespace {
+    const char *buildStageTimes[] = {
+      "preprocess_time",
+      "parse_time",
+      "transform_time",
+      "compile_time",
+      "load_time"
+    };
+  }
+
+  kernelBuildRequest_t::kernelBuildRequest_t(const std::string &filename_,
+                                             const std::string &kernelName_,
+                                             const hash_t &kernelHash_,
+                                             const occa::json &kernelProps_) :
+    filename(filename_),
+    kernelName(kernelName_),
+    kernelHash(kernelHash_),
+    kernelProps(kernelProps_),
+    modeKernel(NULL) {}
+
   modeDevice_t::modeDevice_t(const occa::json &properties_) :
     mode((std::string) properties_["mode"]),
     properties(properties_),
     needsLauncherKernel(false),
     bytesAllocated(0),
-    maxBytesAllocated(0) {}
+    maxBytesAllocated(0),
+    memoryPool(this, properties_.get("memory_pool", false)),
+    capturingGraph(NULL),
+    kernelCacheSize(properties_.get("kernel_cache_size", 512)),
+    kernelCacheHits(0),
+    kernelCacheMisses(0) {
+    buildStats["kernels"] = 0;
+    buildStats["cache_hits"] = 0;
+    buildStats["cache_misses"] = 0;
+    for (const char *stageTime : buildStageTimes) {
+      buildStats[stageTime] = 0.0;
+    }
+    buildStats["total_time"] = 0.0;
+    buildStats["binary_bytes"] = 0;
+    buildStats["builds"].asArray();
+  }
 
   modeDevice_t::~modeDevice_t() {
     // Null all wrappers
@@ -26,6 +66,11 @@ namespace occa {
 
   // Must be called before ~modeDevice_t()!
   void modeDevice_t::freeResources() {
+    writeBuildStats();
+    memoryPool.trim();
+    clearCachedKernels();
+    // Graphs hold references to kernels and memory
+    freeRing<modeGraph_t>(graphRing);
     freeRing<modeKernel_t>(kernelRing);
     freeRing<modeBuffer_t>(memoryRing);
     freeRing<modeStream_t>(streamRing);
@@ -66,10 +111,13 @@ namespace occa {
 
   void modeDevice_t::addStreamRef(modeStream_t *stream) {
     streamRing.addRef(stream);
+    streams.push_back(stream);
   }
 
   void modeDevice_t::removeStreamRef(modeStream_t *stream) {
     streamRing.removeRef(stream);
+    streams.erase(std::remove(streams.begin(), streams.end(), stream),
+                  streams.end());
   }
 
   void modeDevice_t::addStreamTagRef(modeStreamTag_t *streamTag) {
@@ -80,6 +128,14 @@ namespace occa {
     streamTagRing.removeRef(streamTag);
   }
 
+  void modeDevice_t::addGraphRef(modeGraph_t *graph) {
+    graphRing.addRef(graph);
+  }
+
+  void modeDevice_t::removeGraphRef(modeGraph_t *graph) {
+    graphRing.removeRef(graph);
+  }
+
   void modeDevice_t::finish() const {
     currentStream.getModeStream()->finish();
   }
@@ -90,6 +146,10 @@ namespace occa {
     }
   }
 
+  modeGraph_t* modeDevice_t::createGraph() {
+    return new modeGraph_t(this);
+  }
+
   hash_t modeDevice_t::versionedHash() const {
     return (occa::hash(settings()["version"])
             ^ hash());
@@ -127,19 +187,122 @@ namespace occa {
                          kernel->name);
   }
 
-  kernel& modeDevice_t::getCachedKernel(const hash_t &kernelHash,
-                                        const std::string &kernelName) {
+  kernel modeDevice_t::getCachedKernel(const std::string &cacheKey) {
+    cachedKernelMapIterator it = cachedKernels.find(cacheKey);
+    if (it == cachedKernels.end()) {
+      ++kernelCacheMisses;
+      return kernel();
+    }
+
+    // The cached kernel was freed, for example by freeing the device
+    if (!it->second.isInitialized()) {
+      cachedKernels.erase(it);
+      cachedKernelOrder.remove(cacheKey);
+      ++kernelCacheMisses;
+      return kernel();
+    }
+
+    // Mark as most recently used
+    if (cachedKernelOrder.front() != cacheKey) {
+      cachedKernelOrder.remove(cacheKey);
+      cachedKernelOrder.push_front(cacheKey);
+    }
+
+    ++kernelCacheHits;
+    // Each caller gets its own kernel so arguments and frees aren't shared
+    return kernel(it->second.getModeKernel()->clone());
+  }
+
+  void modeDevice_t::setCachedKernel(const std::string &cacheKey,
+                                     kernel &cachedKernel) {
+    if (kernelCacheSize <= 0 || !cachedKernel.isInitialized()) {
+      return;
+    }
+
+    // The cache keeps a private clone so callers can free theirs
+    kernel prototype(cachedKernel.getModeKernel()->clone());
+    if (!prototype.isInitialized()) {
+      return;
+    }
+
+    if (cachedKernels.find(cacheKey) != cachedKernels.end()) {
+      cachedKernelOrder.remove(cacheKey);
+    }
+    cachedKernels[cacheKey] = prototype;
+    cachedKernelOrder.push_front(cacheKey);
 
-    return cachedKernels[getKernelHash(kernelHash, kernelName)];
+    // Dropping the cache reference frees kernels no longer used elsewhere
+    while ((int) cachedKernelOrder.size() > kernelCacheSize) {
+      cachedKernels.erase(cachedKernelOrder.back());
+      cachedKernelOrder.pop_back();
+    }
   }
 
   void modeDevice_t::removeCachedKernel(modeKernel_t *kernel) {
     if (kernel == NULL) {
       return;
     }
-    cachedKernelMapIterator it = cachedKernels.find(getKernelHash(kernel));
-    if (it != cachedKernels.end()) {
-      cachedKernels.erase(it);
+    cachedKernelMapIterator it = cachedKernels.begin();
+    while (it != cachedKernels.end()) {
+      if (it->second.getModeKernel() == kernel) {
+        cachedKernelOrder.remove(it->first);
+        it = cachedKernels.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void modeDevice_t::clearCachedKernels() {
+    cachedKernels.clear();
+    cachedKernelOrder.clear();
+  }
+
+  void modeDevice_t::addBuildStats(modeKernel_t *kernel) {
+    occa::json kernelStats = kernel->buildStats;
+    kernelStats["name"] = kernel->name;
+    kernelStats["source"] = kernel->sourceFilename;
+
+    buildStats["kernels"] += 1;
+    if (kernelStats.get("cache_hit", false)) {
+      buildStats["cache_hits"] += 1;
+    } else {
+      buildStats["cache_misses"] += 1;
+    }
+    for (const char *stageTime : buildStageTimes) {
+      buildStats[stageTime] += kernelStats.get(stageTime, 0.0);
+    }
+    buildStats["binary_bytes"] += kernelStats.get<udim_t>("binary_bytes", 0);
+    buildStats["builds"] += kernelStats;
+  }
+
+  void modeDevice_t::addBuildTime(const double buildTime) {
+    buildStats["total_time"] += buildTime;
+  }
+
+  void modeDevice_t::writeBuildStats() const {
+    const std::string filename = env::var("OCCA_BUILD_STATS");
+    if (filename.empty() || !buildStats.get("kernels", 0)) {
+      return;
+    }
+
+    occa::json record;
+    record["mode"] = mode;
+    record["pid"] = sys::getPID();
+    record["stats"] = buildStats;
+
+    // Appending keeps the records of every device and process
+    std::ofstream fs(io::expandFilename(filename), std::ios::app);
+    fs << record.dump(0) << '\n';
+  }
+
+  void modeDevice_t::buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                                  const int jobs) {
+    for (kernelBuildRequest_t &request : requests) {
+      request.modeKernel = buildKernel(request.filename,
+                                       request.kernelName,
+                                       request.kernelHash,
+                                       request.kernelProps);
     }
   }
 }
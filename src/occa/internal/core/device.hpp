@@ -1,12 +1,29 @@
 #ifndef OCCA_INTERNAL_CORE_DEVICE_HEADER
 #define OCCA_INTERNAL_CORE_DEVICE_HEADER
 
+#include <list>
+
 #include <occa/core/device.hpp>
 #include <occa/types/json.hpp>
 #include <occa/internal/utils/gc.hpp>
+#include <occa/internal/core/memoryPool.hpp>
 #include <occa/internal/lang/kernelMetadata.hpp>
 
 namespace occa {
+  class kernelBuildRequest_t {
+   public:
+    std::string filename;
+    std::string kernelName;
+    hash_t kernelHash;
+    occa::json kernelProps;
+    modeKernel_t *modeKernel;
+
+    kernelBuildRequest_t(const std::string &filename_,
+                         const std::string &kernelName_,
+                         const hash_t &kernelHash_,
+                         const occa::json &kernelProps_);
+  };
+
   class modeDevice_t {
    public:
     std::string mode;
@@ -18,6 +35,7 @@ namespace occa {
     gc::ring_t<modeBuffer_t> memoryRing;
     gc::ring_t<modeStream_t> streamRing;
     gc::ring_t<modeStreamTag_t> streamTagRing;
+    gc::ring_t<modeGraph_t> graphRing;
 
     stream currentStream;
     std::vector<modeStream_t*> streams;
@@ -25,7 +43,20 @@ namespace occa {
     udim_t bytesAllocated;
     udim_t maxBytesAllocated;
 
+    memoryPool_t memoryPool;
+
+    // Graph recording kernel launches and copies instead of running them
+    modeGraph_t *capturingGraph;
+
+    // In-process kernel cache with least-recently-used eviction
     cachedKernelMap cachedKernels;
+    std::list<std::string> cachedKernelOrder;
+    int kernelCacheSize;
+    udim_t kernelCacheHits;
+    udim_t kernelCacheMisses;
+
+    // Totals and per-kernel entries of the kernels built by this device
+    occa::json buildStats;
 
     modeDevice_t(const occa::json &json_);
 
@@ -58,6 +89,9 @@ namespace occa {
     void addStreamTagRef(modeStreamTag_t *streamTag);
     void removeStreamTagRef(modeStreamTag_t *streamTag);
 
+    void addGraphRef(modeGraph_t *graph);
+    void removeGraphRef(modeGraph_t *graph);
+
     void finish() const;
     void finishAll() const;
 
@@ -80,6 +114,11 @@ namespace occa {
                                const streamTag &endTag) = 0;
     //  |===============================
 
+    //  |---[ Graph ]-------------------
+    // Backends override this to replay graphs with less overhead than separate launches
+    virtual modeGraph_t* createGraph();
+    //  |===============================
+
     //  |---[ Kernel ]------------------
     void writeKernelBuildFile(const std::string &filename,
                               const hash_t &kernelHash,
@@ -94,16 +133,34 @@ namespace occa {
 
     std::string getKernelHash(modeKernel_t *kernel);
 
-    kernel& getCachedKernel(const hash_t &kernelHash,
-                            const std::string &kernelName);
+    kernel getCachedKernel(const std::string &cacheKey);
+
+    void setCachedKernel(const std::string &cacheKey,
+                         kernel &cachedKernel);
 
     void removeCachedKernel(modeKernel_t *kernel);
 
+    void clearCachedKernels();
+
+    // Adds the stats of a newly built kernel to the device totals
+    void addBuildStats(modeKernel_t *kernel);
+
+    // Wall time spent building kernels, including hashing and waiting on cache locks
+    void addBuildTime(const double buildTime);
+
+    // Appends the build stats as a JSON line to ${OCCA_BUILD_STATS}, if set
+    void writeBuildStats() const;
+
     virtual modeKernel_t* buildKernel(const std::string &filename,
                                       const std::string &kernelName,
                                       const hash_t hash,
                                       const occa::json &props) = 0;
 
+    // Builds each request and sets its modeKernel (NULL on failure)
+    // Backends override this to compile up to [jobs] kernels concurrently
+    virtual void buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                              const int jobs);
+
     virtual modeKernel_t* buildKernelFromBinary(const std::string &filename,
                                                 const std::string &kernelName,
                                                 const occa::json &props) = 0;
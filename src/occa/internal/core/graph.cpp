@@ -0,0 +1,178 @@
+#include <algorithm>
+
+#include <occa/internal/core/device.hpp>
+#include <occa/internal/core/graph.hpp>
+#include <occa/internal/core/kernel.hpp>
+#include <occa/internal/core/memory.hpp>
+
+namespace occa {
+  namespace graphNodeType {
+    const int kernel = (1 << 0);
+    const int copy   = (1 << 1);
+  }
+
+  graphNode_t::graphNode_t() :
+    type(0),
+    hostDest(NULL),
+    hostSrc(NULL),
+    bytes(0),
+    destOffset(0),
+    srcOffset(0) {}
+
+  modeGraph_t::modeGraph_t(modeDevice_t *modeDevice_) :
+    modeDevice(modeDevice_),
+    isCapturing(true) {
+    modeDevice->addGraphRef(this);
+  }
+
+  modeGraph_t::~modeGraph_t() {
+    // NULL all wrappers
+    while (graphRing.head) {
+      graph *g = (graph*) graphRing.head;
+      graphRing.removeRef(g);
+      g->modeGraph = NULL;
+    }
+    if (modeDevice) {
+      // Queued replays may still reference the nodes
+      modeDevice->finishAll();
+
+      if (modeDevice->capturingGraph == this) {
+        modeDevice->capturingGraph = NULL;
+      }
+      modeDevice->removeGraphRef(this);
+    }
+  }
+
+  void modeGraph_t::dontUseRefs() {
+    graphRing.dontUseRefs();
+  }
+
+  void modeGraph_t::addGraphRef(graph *g) {
+    graphRing.addRef(g);
+  }
+
+  void modeGraph_t::removeGraphRef(graph *g) {
+    graphRing.removeRef(g);
+  }
+
+  bool modeGraph_t::needsFree() const {
+    return graphRing.needsFree();
+  }
+
+  void modeGraph_t::addKernelNode(modeKernel_t *modeKernel) {
+    nodes.push_back(graphNode_t());
+    graphNode_t &node = nodes.back();
+
+    node.type = graphNodeType::kernel;
+    node.kernel = occa::kernel(modeKernel);
+    node.outerDims = modeKernel->outerDims;
+    node.innerDims = modeKernel->innerDims;
+    node.arguments = modeKernel->arguments;
+    for (const kernelArgData &arg : node.arguments) {
+      if (arg.modeMemory) {
+        node.argumentMemory.push_back(occa::memory(arg.modeMemory));
+      }
+    }
+  }
+
+  void modeGraph_t::addCopyNode(modeMemory_t *dest,
+                                const modeMemory_t *src,
+                                const udim_t bytes,
+                                const udim_t destOffset,
+                                const udim_t srcOffset,
+                                const occa::json &props) {
+    nodes.push_back(graphNode_t());
+    graphNode_t &node = nodes.back();
+
+    node.type = graphNodeType::copy;
+    node.dest = occa::memory(dest);
+    node.src = occa::memory(const_cast<modeMemory_t*>(src));
+    node.bytes = bytes;
+    node.destOffset = destOffset;
+    node.srcOffset = srcOffset;
+    node.props = props;
+  }
+
+  void modeGraph_t::addCopyNode(modeMemory_t *dest,
+                                const void *src,
+                                const udim_t bytes,
+                                const udim_t offset,
+                                const occa::json &props) {
+    nodes.push_back(graphNode_t());
+    graphNode_t &node = nodes.back();
+
+    node.type = graphNodeType::copy;
+    node.dest = occa::memory(dest);
+    node.hostSrc = src;
+    node.bytes = bytes;
+    node.destOffset = offset;
+    node.props = props;
+  }
+
+  void modeGraph_t::addCopyNode(void *dest,
+                                const modeMemory_t *src,
+                                const udim_t bytes,
+                                const udim_t offset,
+                                const occa::json &props) {
+    nodes.push_back(graphNode_t());
+    graphNode_t &node = nodes.back();
+
+    node.type = graphNodeType::copy;
+    node.hostDest = dest;
+    node.src = occa::memory(const_cast<modeMemory_t*>(src));
+    node.bytes = bytes;
+    node.srcOffset = offset;
+    node.props = props;
+  }
+
+  void modeGraph_t::runNode(graphNode_t &node) {
+    if (node.type == graphNodeType::kernel) {
+      modeKernel_t *modeKernel = node.kernel.getModeKernel();
+      OCCA_ERROR("Graph kernel has been freed",
+                 modeKernel != NULL);
+
+      // Launch with the captured bindings, restoring the ones set on the kernel afterwards
+      std::vector<kernelArgData> arguments = node.arguments;
+      dim outerDims = node.outerDims;
+      dim innerDims = node.innerDims;
+      auto swapBindings = [&]() {
+        std::swap(modeKernel->arguments, arguments);
+        std::swap(modeKernel->outerDims, outerDims);
+        std::swap(modeKernel->innerDims, innerDims);
+      };
+
+      swapBindings();
+      try {
+        modeKernel->run();
+      } catch (...) {
+        swapBindings();
+        throw;
+      }
+      swapBindings();
+      return;
+    }
+
+    modeMemory_t *dest = node.dest.getModeMemory();
+    modeMemory_t *src = node.src.getModeMemory();
+    OCCA_ERROR("Graph copy memory has been freed",
+               (dest || node.hostDest) && (src || node.hostSrc));
+
+    if (node.hostDest) {
+      src->copyTo(node.hostDest, node.bytes, node.srcOffset, node.props);
+    } else if (node.hostSrc) {
+      dest->copyFrom(node.hostSrc, node.bytes, node.destOffset, node.props);
+    } else {
+      dest->copyFrom(src, node.bytes, node.destOffset, node.srcOffset, node.props);
+    }
+  }
+
+  void modeGraph_t::finalize() {
+    isCapturing = false;
+  }
+
+  void modeGraph_t::launch() {
+    for (graphNode_t &node : nodes) {
+      runNode(node);
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#ifndef OCCA_INTERNAL_CORE_GRAPH_HEADER
+#define OCCA_INTERNAL_CORE_GRAPH_HEADER
+
+#include <vector>
+
+#include <occa/core/graph.hpp>
+#include <occa/core/kernel.hpp>
+#include <occa/core/memory.hpp>
+#include <occa/types/json.hpp>
+#include <occa/internal/utils/gc.hpp>
+
+namespace occa {
+  namespace graphNodeType {
+    extern const int kernel;
+    extern const int copy;
+  }
+
+  // A recorded kernel launch or copy
+  class graphNode_t {
+   public:
+    int type;
+
+    // Kernel launches
+    occa::kernel kernel;
+    dim outerDims, innerDims;
+    std::vector<kernelArgData> arguments;
+    // Keeps the memory arguments alive
+    std::vector<occa::memory> argumentMemory;
+
+    // Copies to [dest] or [hostDest] from [src] or [hostSrc]
+    occa::memory dest, src;
+    void *hostDest;
+    const void *hostSrc;
+    udim_t bytes;
+    udim_t destOffset, srcOffset;
+    occa::json props;
+
+    graphNode_t();
+  };
+
+  class modeGraph_t : public gc::ringEntry_t {
+   public:
+    modeDevice_t *modeDevice;
+    std::vector<graphNode_t> nodes;
+    bool isCapturing;
+
+    gc::ring_t<graph> graphRing;
+
+    modeGraph_t(modeDevice_t *modeDevice_);
+
+    void dontUseRefs();
+    void addGraphRef(graph *g);
+    void removeGraphRef(graph *g);
+    bool needsFree() const;
+
+    // Arguments and run dims are copied from [modeKernel]
+    void addKernelNode(modeKernel_t *modeKernel);
+
+    void addCopyNode(modeMemory_t *dest,
+                     const modeMemory_t *src,
+                     const udim_t bytes,
+                     const udim_t destOffset,
+                     const udim_t srcOffset,
+                     const occa::json &props);
+
+    void addCopyNode(modeMemory_t *dest,
+                     const void *src,
+                     const udim_t bytes,
+                     const udim_t offset,
+                     const occa::json &props);
+
+    void addCopyNode(void *dest,
+                     const modeMemory_t *src,
+                     const udim_t bytes,
+                     const udim_t offset,
+                     const occa::json &props);
+
+    void runNode(graphNode_t &node);
+
+    //---[ Virtual Methods ]------------
+    virtual ~modeGraph_t();
+
+    // Called once the capture ends, before the first launch
+    virtual void finalize();
+
+    // Replays the nodes on the current stream without validating the arguments again
+    virtual void launch();
+    //==================================
+  };
+}
+
+#endif
@@ -3,6 +3,11 @@
 #include <occa/internal/core/memory.hpp>
 
 namespace occa {
+  namespace {
+    // Distinguishes NULL pointer arguments from non-pointer arguments
+    const char nullArgType = 0;
+  }
+
   modeKernel_t::modeKernel_t(modeDevice_t *modeDevice_,
                              const std::string &name_,
                              const std::string &sourceFilename_,
@@ -10,7 +15,8 @@ namespace occa {
     modeDevice(modeDevice_),
     name(name_),
     sourceFilename(sourceFilename_),
-    properties(properties_) {
+    properties(properties_),
+    hasValidatedArgTypes(false) {
     modeDevice->addKernelRef(this);
   }
 
@@ -27,6 +33,10 @@ namespace occa {
     }
   }
 
+  modeKernel_t* modeKernel_t::clone() const {
+    return NULL;
+  }
+
   void modeKernel_t::dontUseRefs() {
     kernelRing.dontUseRefs();
   }
@@ -80,6 +90,40 @@ namespace occa {
     assertArgumentLimit();
   }
 
+  const void* modeKernel_t::getArgType(const kernelArgData &arg) {
+    modeMemory_t *mem = arg.getModeMemory();
+    if (mem) {
+      return mem->dtype_;
+    }
+    if (arg.value.isNull()) {
+      return &nullArgType;
+    }
+    return NULL;
+  }
+
+  bool modeKernel_t::argTypesWereValidated() const {
+    const int argc = (int) arguments.size();
+    if (!hasValidatedArgTypes
+        || (argc != (int) validatedArgTypes.size())) {
+      return false;
+    }
+    for (int i = 0; i < argc; ++i) {
+      if (getArgType(arguments[i]) != validatedArgTypes[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void modeKernel_t::setValidatedArgTypes() {
+    const int argc = (int) arguments.size();
+    validatedArgTypes.resize(argc);
+    for (int i = 0; i < argc; ++i) {
+      validatedArgTypes[i] = getArgType(arguments[i]);
+    }
+    hasValidatedArgTypes = true;
+  }
+
   void modeKernel_t::setupRun() {
     const int argc = (int) arguments.size();
 
@@ -92,6 +136,11 @@ namespace occa {
       return;
     }
 
+    // Repeated launches with the same argument types skip validation
+    if (argTypesWereValidated()) {
+      return;
+    }
+
     const int metaArgc = (int) metadata.arguments.size();
 
     OCCA_ERROR("(" << hash << ":" << name << ") Kernel expects ["
@@ -128,6 +177,8 @@ namespace occa {
                  << "Received type: " << *(mem->dtype_) << '\n',
                  mem->dtype_->canBeCastedTo(argInfo.dtype));
     }
+
+    setValidatedArgTypes();
   }
 
   bool modeKernel_t::isNoop() const {
@@ -16,11 +16,20 @@ namespace occa {
     occa::json properties;
     hash_t hash;
 
+    // Set by the backend when building the kernel
+    //   cache_hit, binary_bytes, and the seconds spent in
+    //   preprocess_time, parse_time, transform_time, compile_time and load_time
+    occa::json buildStats;
+
     // Requirements to launch kernel
     dim outerDims, innerDims;
     std::vector<kernelArgData> arguments;
     lang::kernelMetadata_t metadata;
 
+    // Argument types from the last launch that passed type validation
+    std::vector<const void*> validatedArgTypes;
+    bool hasValidatedArgTypes;
+
     // References
     gc::ring_t<kernel> kernelRing;
 
@@ -44,6 +53,10 @@ namespace occa {
 
     void setSourceMetadata(lang::parser_t &parser);
 
+    static const void* getArgType(const kernelArgData &arg);
+    bool argTypesWereValidated() const;
+    void setValidatedArgTypes();
+
     void setupRun();
 
     bool isNoop() const;
@@ -58,6 +71,10 @@ namespace occa {
     virtual const lang::kernelMetadata_t& getMetadata() const = 0;
 
     virtual void run() const = 0;
+
+    // Returns a new kernel sharing the loaded binary but with its own
+    //   arguments and lifetime, or NULL if the backend can't share it
+    virtual modeKernel_t* clone() const;
     //==================================
   };
 }
@@ -7,6 +7,7 @@
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
 #include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/sys.hpp>
 
 namespace occa {
   launchedModeDevice_t::launchedModeDevice_t(const occa::json &properties_) :
@@ -98,6 +99,7 @@ namespace occa {
     const bool foundBinary = io::isFile(binaryFilename);
 
     const bool verbose = kernelProps.get("verbose", false);
+    const double startTime = sys::currentTime();
     if (foundBinary) {
       if (verbose) {
         io::stdout << "Loading cached ["
@@ -107,6 +109,7 @@ namespace occa {
                    << "] in [" << binaryFilename << "]\n";
       }
 
+      modeKernel_t *k;
       if (usingOkl) {
         lang::sourceMetadata_t launcherMetadata = (
           lang::sourceMetadata_t::fromBuildFile(hashDir + kc::launcherBuildFile)
@@ -114,19 +117,25 @@ namespace occa {
         lang::sourceMetadata_t deviceMetadata = (
           lang::sourceMetadata_t::fromBuildFile(hashDir + kc::buildFile)
         );
-        return buildOKLKernelFromBinary(kernelHash,
-                                        hashDir,
-                                        kernelName,
-                                        sourceFilename,
-                                        binaryFilename,
-                                        launcherMetadata,
-                                        deviceMetadata,
-                                        kernelProps);
-      } else {
-        return buildKernelFromBinary(binaryFilename,
+        k = buildOKLKernelFromBinary(kernelHash,
+                                     hashDir,
                                      kernelName,
+                                     sourceFilename,
+                                     binaryFilename,
+                                     launcherMetadata,
+                                     deviceMetadata,
                                      kernelProps);
+      } else {
+        k = buildKernelFromBinary(binaryFilename,
+                                  kernelName,
+                                  kernelProps);
+      }
+      if (k) {
+        k->buildStats["cache_hit"] = true;
+        k->buildStats["load_time"] = sys::currentTime() - startTime;
+        k->buildStats["binary_bytes"] = io::fileSize(binaryFilename);
       }
+      return k;
     }
 
     lang::sourceMetadata_t launcherMetadata, deviceMetadata;
@@ -200,6 +209,22 @@ namespace occa {
       }
     );
 
+    if (k) {
+      // Backends load the binary while compiling it, so it's part of compile_time
+      const double translateTime = (
+        deviceMetadata.preprocessTime
+        + deviceMetadata.parseTime
+        + deviceMetadata.transformTime
+      );
+      occa::json &stats = k->buildStats;
+      stats["cache_hit"] = false;
+      stats["preprocess_time"] = deviceMetadata.preprocessTime;
+      stats["parse_time"] = deviceMetadata.parseTime;
+      stats["transform_time"] = deviceMetadata.transformTime;
+      stats["compile_time"] = sys::currentTime() - startTime - translateTime;
+      stats["binary_bytes"] = io::fileSize(binaryFilename);
+    }
+
     return k;
   }
 
@@ -1,6 +1,7 @@
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/buffer.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
+#include <occa/internal/core/memoryPool.hpp>
 
 namespace occa {
 
@@ -66,6 +67,10 @@ namespace occa {
 
   void modeMemory_t::free() {
     if (modeBuffer == NULL) return;
+    if (modeBuffer->memoryPool) {
+      modeBuffer->memoryPool->release(modeBuffer);
+      return;
+    }
     delete modeBuffer;
   }
 
@@ -0,0 +1,144 @@
+#include <algorithm>
+
+#include <occa/internal/core/buffer.hpp>
+#include <occa/internal/core/device.hpp>
+#include <occa/internal/core/memory.hpp>
+#include <occa/internal/core/memoryPool.hpp>
+
+namespace occa {
+  pooledBuffer_t::pooledBuffer_t(modeBuffer_t *buffer_,
+                                 const occa::stream &releaseStream_) :
+    buffer(buffer_),
+    releaseStream(releaseStream_) {}
+
+  memoryPool_t::memoryPool_t(modeDevice_t *modeDevice_,
+                             const bool enabled_) :
+    modeDevice(modeDevice_),
+    enabled(enabled_),
+    hits(0),
+    misses(0),
+    bytesInUse(0),
+    bytesIdle(0) {}
+
+  udim_t memoryPool_t::getSizeClass(const udim_t bytes) {
+    const udim_t minBytes = 256;
+    if (bytes <= minBytes) {
+      return minBytes;
+    }
+
+    udim_t powerOfTwo = minBytes;
+    while ((powerOfTwo << 1) <= bytes) {
+      powerOfTwo <<= 1;
+    }
+    const udim_t step = powerOfTwo / 4;
+
+    return ((bytes + step - 1) / step) * step;
+  }
+
+  bool memoryPool_t::usePool(const occa::json &props) const {
+    if (!props.isObject()) {
+      return enabled;
+    }
+
+    const bool hasPoolProp = props.has("memory_pool");
+    if (props.size() > (hasPoolProp ? 1 : 0)) {
+      return false;
+    }
+    return props.get("memory_pool", enabled);
+  }
+
+  modeMemory_t* memoryPool_t::malloc(const udim_t bytes,
+                                     const occa::json &props) {
+    const udim_t poolBytes = getSizeClass(bytes);
+
+    std::vector<pooledBuffer_t> &bin = freeBuffers[poolBytes];
+    if (bin.size()) {
+      // Prefer buffers released on the current stream since its work is already ordered
+      const occa::stream &currentStream = modeDevice->currentStream;
+      std::vector<pooledBuffer_t>::iterator it = std::find_if(
+        bin.begin(), bin.end(),
+        [&](const pooledBuffer_t &pooledBuffer) {
+          return pooledBuffer.releaseStream == currentStream;
+        }
+      );
+      if (it == bin.end()) {
+        it = bin.end() - 1;
+        it->releaseStream.finish();
+      }
+
+      modeBuffer_t *buffer = it->buffer;
+      bin.erase(it);
+
+      ++hits;
+      bytesIdle -= poolBytes;
+      bytesInUse += poolBytes;
+
+      return buffer->slice(0, bytes);
+    }
+
+    modeMemory_t *mem = modeDevice->malloc(poolBytes, NULL, props);
+    modeBuffer_t *buffer = mem->modeBuffer;
+    buffer->memoryPool = this;
+
+    if (bytes < poolBytes) {
+      modeMemory_t *sliceMem = buffer->slice(0, bytes);
+      delete mem;
+      mem = sliceMem;
+    }
+
+    ++misses;
+    bytesInUse += poolBytes;
+
+    modeDevice->bytesAllocated += poolBytes;
+    modeDevice->maxBytesAllocated = std::max(
+      modeDevice->maxBytesAllocated, modeDevice->bytesAllocated
+    );
+
+    return mem;
+  }
+
+  void memoryPool_t::release(modeBuffer_t *buffer) {
+    // Explicitly freed buffers can still have slices
+    while (buffer->modeMemoryRing.head) {
+      modeMemory_t *mem = (modeMemory_t*) buffer->modeMemoryRing.head;
+      buffer->removeModeMemoryRef(mem);
+      mem->modeBuffer = NULL;
+
+      delete mem;
+    }
+
+    bytesInUse -= buffer->size;
+    bytesIdle += buffer->size;
+
+    freeBuffers[buffer->size].push_back(
+      pooledBuffer_t(buffer, modeDevice->currentStream)
+    );
+  }
+
+  void memoryPool_t::trim() {
+    for (auto &it : freeBuffers) {
+      for (pooledBuffer_t &pooledBuffer : it.second) {
+        pooledBuffer.buffer->memoryPool = NULL;
+        delete pooledBuffer.buffer;
+      }
+    }
+    freeBuffers.clear();
+    bytesIdle = 0;
+  }
+
+  occa::json memoryPool_t::getStats() const {
+    udim_t idleBuffers = 0;
+    for (auto &it : freeBuffers) {
+      idleBuffers += it.second.size();
+    }
+
+    occa::json stats;
+    stats["enabled"] = enabled;
+    stats["hits"] = hits;
+    stats["misses"] = misses;
+    stats["bytes_in_use"] = bytesInUse;
+    stats["bytes_idle"] = bytesIdle;
+    stats["idle_buffers"] = idleBuffers;
+    return stats;
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef OCCA_INTERNAL_CORE_MEMORYPOOL_HEADER
+#define OCCA_INTERNAL_CORE_MEMORYPOOL_HEADER
+
+#include <map>
+#include <vector>
+
+#include <occa/core/stream.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  class modeBuffer_t;
+  class modeDevice_t;
+  class modeMemory_t;
+
+  class pooledBuffer_t {
+   public:
+    modeBuffer_t *buffer;
+    // Work queued before the release can still be using the buffer
+    occa::stream releaseStream;
+
+    pooledBuffer_t(modeBuffer_t *buffer_,
+                   const occa::stream &releaseStream_);
+  };
+
+  // Keeps released buffers binned by size class so later allocations can reuse them
+  //   instead of going through the backend allocator
+  class memoryPool_t {
+   public:
+    modeDevice_t *modeDevice;
+    bool enabled;
+
+    std::map<udim_t, std::vector<pooledBuffer_t>> freeBuffers;
+
+    udim_t hits;
+    udim_t misses;
+    udim_t bytesInUse;
+    udim_t bytesIdle;
+
+    memoryPool_t(modeDevice_t *modeDevice_,
+                 const bool enabled_);
+
+    // Sizes are rounded up to a quarter of their power of two, wasting at most 25%
+    static udim_t getSizeClass(const udim_t bytes);
+
+    // Only allocations without custom properties are pooled
+    bool usePool(const occa::json &props) const;
+
+    modeMemory_t* malloc(const udim_t bytes,
+                         const occa::json &props);
+
+    // Called instead of deleting buffers allocated through the pool
+    void release(modeBuffer_t *buffer);
+
+    // Frees all idle buffers
+    void trim();
+
+    occa::json getStats() const;
+  };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <occa/internal/io/cache.hpp>
 #include <occa/internal/io/enums.hpp>
+#include <occa/internal/io/lock.hpp>
 #include <occa/internal/io/output.hpp>
 #include <occa/internal/io/utils.hpp>
 
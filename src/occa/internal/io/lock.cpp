@@ -0,0 +1,203 @@
+#include <occa/defines.hpp>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include <occa/internal/io/lock.hpp>
+#include <occa/internal/io/output.hpp>
+#include <occa/internal/io/utils.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/types/json.hpp>
+#include <occa/utils/env.hpp>
+
+namespace occa {
+  namespace io {
+    namespace {
+      // Unlike io::read, missing files read as empty since locks can be released at any time
+      std::string readOwnerFile(const std::string &filename) {
+        std::ifstream file(filename.c_str());
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+      }
+    }
+
+    lock_t::lock_t(const hash_t &hash,
+                   const std::string &tag) :
+      lockDir(env::OCCA_CACHE_DIR + "locks/" + hash.getString() + "_" + tag),
+      ownerFilename(lockDir + "/owner"),
+      staleWarning(settings().get("locks/stale_warning", 10.0)),
+      staleAge(settings().get("locks/stale_age", 20.0)),
+      timeout(settings().get("locks/timeout", 600.0)),
+      isMine_(false),
+      stopHeartbeat(false) {}
+
+    lock_t::~lock_t() {
+      release();
+    }
+
+    const std::string& lock_t::dir() const {
+      return lockDir;
+    }
+
+    bool lock_t::isMine() const {
+      return isMine_;
+    }
+
+    std::string lock_t::getOwner() {
+      char hostname[256] = {0};
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      ::gethostname(hostname, sizeof(hostname) - 1);
+#endif
+      return std::string(hostname) + " " + occa::toString(sys::getPID());
+    }
+
+    bool lock_t::tryAcquire() {
+      if (isMine_) {
+        return true;
+      }
+
+      sys::mkpath(env::OCCA_CACHE_DIR + "locks/");
+
+      // Only one stale lock removal is attempted per call
+      for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!sys::mkdir(lockDir)) {
+          io::write(ownerFilename, getOwner());
+          isMine_ = true;
+          startHeartbeat();
+          return true;
+        }
+        if (!removeStaleLock()) {
+          return false;
+        }
+      }
+      return false;
+    }
+
+    bool lock_t::removeStaleLock() {
+      // Identify the lock seen as stale, it could be replaced by a new owner before it's removed
+      struct stat staleInfo;
+      if (::stat(lockDir.c_str(), &staleInfo)) {
+        // Lock was just released, let the caller retry
+        return true;
+      }
+      const std::string staleOwner = readOwnerFile(ownerFilename);
+      if (!isStale()) {
+        return false;
+      }
+
+      // Only one waiter can move the lock aside, the others fail the rename
+      const std::string staleDir = lockDir + "_stale_" + hash_t::random().getString();
+      if (std::rename(lockDir.c_str(), staleDir.c_str())) {
+        return false;
+      }
+
+      // Put back locks that were acquired after the staleness check
+      struct stat movedInfo;
+      if (::stat(staleDir.c_str(), &movedInfo)
+          || (movedInfo.st_dev != staleInfo.st_dev)
+          || (movedInfo.st_ino != staleInfo.st_ino)
+          || (readOwnerFile(staleDir + "/owner") != staleOwner)) {
+        std::rename(staleDir.c_str(), lockDir.c_str());
+        return false;
+      }
+
+      std::remove((staleDir + "/owner").c_str());
+      sys::rmdir(staleDir);
+      return true;
+    }
+
+    void lock_t::acquire() {
+      const double startTime = sys::currentTime();
+      bool warned = false;
+      // Back off to avoid hammering shared filesystems with metadata requests
+      int sleepMilliseconds = 10;
+      while (!tryAcquire()) {
+        const double waitTime = sys::currentTime() - startTime;
+        if ((timeout > 0) && (waitTime > timeout)) {
+          OCCA_FORCE_ERROR("Timed out after " << timeout << " seconds waiting on lock"
+                           << " [" << lockDir << "] held by [" << io::read(ownerFilename) << "]");
+        }
+        if (!warned && (waitTime > staleWarning)) {
+          io::stderr << "Waiting on lock [" << lockDir << "]"
+                     << " held by [" << io::read(ownerFilename) << "]\n";
+          warned = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMilliseconds));
+        sleepMilliseconds = std::min(2 * sleepMilliseconds, 500);
+      }
+    }
+
+    void lock_t::release() {
+      if (!isMine_) {
+        return;
+      }
+
+      if (heartbeat.joinable()) {
+        {
+          std::unique_lock<std::mutex> lock(heartbeatMutex);
+          stopHeartbeat = true;
+          heartbeatCondition.notify_all();
+        }
+        heartbeat.join();
+      }
+
+      std::remove(ownerFilename.c_str());
+      sys::rmdir(lockDir);
+      isMine_ = false;
+    }
+
+    bool lock_t::isStale() const {
+      // Owners on the same host can be checked directly
+      std::stringstream owner(
+        io::isFile(ownerFilename) ? io::read(ownerFilename) : ""
+      );
+      std::string ownerHost;
+      int ownerPID = -1;
+      owner >> ownerHost >> ownerPID;
+
+      std::stringstream self(getOwner());
+      std::string host;
+      self >> host;
+
+      if ((ownerPID > 0) && (ownerHost == host)) {
+        return !sys::pidExists(ownerPID);
+      }
+
+      // The owner file is refreshed by the heartbeat, the lock directory is used
+      //   if the owner died before writing it
+      struct stat statInfo;
+      if (::stat(ownerFilename.c_str(), &statInfo) &&
+          ::stat(lockDir.c_str(), &statInfo)) {
+        // Lock was just released
+        return false;
+      }
+      return (std::difftime(std::time(NULL), statInfo.st_mtime) > staleAge);
+    }
+
+    void lock_t::startHeartbeat() {
+      if (staleAge <= 0) {
+        return;
+      }
+      stopHeartbeat = false;
+      heartbeat = std::thread([&]() {
+        std::unique_lock<std::mutex> lock(heartbeatMutex);
+        const auto interval = std::chrono::duration<double>(staleAge / 4);
+        while (!heartbeatCondition.wait_for(lock, interval, [&]() { return stopHeartbeat; })) {
+          io::write(ownerFilename, getOwner());
+        }
+      });
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#ifndef OCCA_INTERNAL_IO_LOCK_HEADER
+#define OCCA_INTERNAL_IO_LOCK_HEADER
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <occa/utils/hash.hpp>
+
+namespace occa {
+  namespace io {
+    // Cross-process lock on a cache entry, backed by a directory in ${OCCA_CACHE_DIR}/locks
+    //   since mkdir is atomic even on shared filesystems
+    // Locks whose owner died or stopped refreshing the lock for [locks/stale_age] seconds
+    //   are treated as stale and removed
+    class lock_t {
+    private:
+      std::string lockDir;
+      std::string ownerFilename;
+      double staleWarning;
+      double staleAge;
+      double timeout;
+      bool isMine_;
+
+      // Keeps the lock fresh while long builds hold it
+      std::thread heartbeat;
+      std::mutex heartbeatMutex;
+      std::condition_variable heartbeatCondition;
+      bool stopHeartbeat;
+
+    public:
+      lock_t(const hash_t &hash,
+             const std::string &tag);
+      ~lock_t();
+
+      const std::string& dir() const;
+
+      bool isMine() const;
+
+      // Returns false right away if another process holds the lock
+      bool tryAcquire();
+
+      // Blocks until the lock is acquired, erroring out after [locks/timeout] seconds
+      void acquire();
+
+      void release();
+
+      bool isStale() const;
+
+    private:
+      static std::string getOwner();
+      // Returns true if the lock is gone and acquiring it can be retried
+      bool removeStaleLock();
+      void startHeartbeat();
+    };
+  }
+}
+
+#endif
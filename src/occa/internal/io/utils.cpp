@@ -34,6 +34,7 @@ namespace occa {
     const std::string launcherSourceFile = "launcher_source.cpp";
     const std::string buildFile          = "build.json";
     const std::string launcherBuildFile  = "launcher_build.json";
+    const std::string preludeHeaderFile  = "kernel_prelude.hpp";
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
     const std::string binaryFile         = "binary";
     const std::string launcherBinaryFile = "launcher_binary";
@@ -318,6 +319,31 @@ namespace occa {
               ((statInfo.st_mode & S_IFMT) == S_IFREG));
     }
 
+    udim_t fileSize(const std::string &filename) {
+      const std::string expFilename = io::expandFilename(filename);
+      struct stat statInfo;
+      if ((stat(expFilename.c_str(), &statInfo) != 0) ||
+          ((statInfo.st_mode & S_IFMT) != S_IFREG)) {
+        return 0;
+      }
+      return (udim_t) statInfo.st_size;
+    }
+
+    udim_t fileModifiedTime(const std::string &filename) {
+      const std::string expFilename = io::expandFilename(filename);
+      struct stat statInfo;
+      if (stat(expFilename.c_str(), &statInfo) != 0) {
+        return 0;
+      }
+#if (OCCA_OS & OCCA_LINUX_OS)
+      return ((udim_t) statInfo.st_mtim.tv_sec * 1000000000) + statInfo.st_mtim.tv_nsec;
+#elif (OCCA_OS & OCCA_MACOS_OS)
+      return ((udim_t) statInfo.st_mtimespec.tv_sec * 1000000000) + statInfo.st_mtimespec.tv_nsec;
+#else
+      return (udim_t) statInfo.st_mtime * 1000000000;
+#endif
+    }
+
     bool isDir(const std::string &filename) {
       const std::string expFilename = io::expandFilename(filename);
       struct stat statInfo;
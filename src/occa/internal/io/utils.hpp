@@ -18,6 +18,7 @@ namespace occa {
     extern const std::string launcherSourceFile;
     extern const std::string launcherBinaryFile;
     extern const std::string launcherBuildFile;
+    extern const std::string preludeHeaderFile;
   }
 
   namespace io {
@@ -65,6 +66,12 @@ namespace occa {
     bool isDir(const std::string &filename);
     bool isFile(const std::string &filename);
 
+    // Returns 0 if [filename] is not a file
+    udim_t fileSize(const std::string &filename);
+
+    // Returns the modification time in nanoseconds, or 0 if [filename] does not exist
+    udim_t fileModifiedTime(const std::string &filename);
+
     strVector filesInDir(const std::string &dir,
                          const unsigned char fileType);
 
@@ -12,6 +12,7 @@
 #include <occa/internal/lang/builtins/attributes/maxInnerDims.hpp>
 #include <occa/internal/lang/builtins/attributes/noBarrier.hpp>
 #include <occa/internal/lang/builtins/attributes/outer.hpp>
+#include <occa/internal/lang/builtins/attributes/reduction.hpp>
 #include <occa/internal/lang/builtins/attributes/restrict.hpp>
 #include <occa/internal/lang/builtins/attributes/shared.hpp>
 #include <occa/internal/lang/builtins/attributes/tile.hpp>
@@ -113,6 +113,52 @@ namespace occa {
           | operatorType::decrement
         );
       }
+
+      bool atomic::isMinMaxExpression(expressionStatement &exprSmnt,
+                                      std::string &functionName,
+                                      exprNode *&argument) {
+        // Matches [x = min(x, value)] or [x = max(value, x)]
+        if (!(exprSmnt.expr->type() & exprNodeType::binary)) {
+          return false;
+        }
+        binaryOpNode &assignNode = (binaryOpNode&) *(exprSmnt.expr);
+        if (!(assignNode.opType() & operatorType::assign)) {
+          return false;
+        }
+
+        exprNode *value = assignNode.rightValue;
+        while (value->type() & exprNodeType::parentheses) {
+          value = ((parenthesesNode*) value)->value;
+        }
+        if (!(value->type() & exprNodeType::call)) {
+          return false;
+        }
+        callNode &call = (callNode&) *value;
+        if (call.argCount() != 2) {
+          return false;
+        }
+
+        const std::string callName = call.value->toString();
+        if ((callName == "min") || (callName == "fmin")
+            || (callName == "fminf") || (callName == "std::min")) {
+          functionName = "min";
+        } else if ((callName == "max") || (callName == "fmax")
+                   || (callName == "fmaxf") || (callName == "std::max")) {
+          functionName = "max";
+        } else {
+          return false;
+        }
+
+        const std::string target = assignNode.leftValue->toString();
+        if (call.args[0]->toString() == target) {
+          argument = call.args[1];
+        } else if (call.args[1]->toString() == target) {
+          argument = call.args[0];
+        } else {
+          return false;
+        }
+        return true;
+      }
     }
   }
 }
@@ -19,9 +19,19 @@ namespace occa {
       }
 
       bool outer::isValid(const attributeToken_t &attr) const {
-        if (attr.kwargs.size()) {
-          attr.printError("[@outer] does not take kwargs");
-          return false;
+        // Named arguments are OpenMP loop hints, other modes ignore them
+        for (auto &it : attr.kwargs) {
+          const std::string &kwarg = it.first;
+          if ((kwarg == "schedule") || (kwarg == "proc_bind")) {
+            exprNode *expr = it.second.expr;
+            if (!expr || !(expr->type() & exprNodeType::string)) {
+              attr.printError("[@outer] " + kwarg + " must be a string");
+              return false;
+            }
+          } else if ((kwarg != "chunk") && (kwarg != "num_threads")) {
+            attr.printError("[@outer] does not take kwarg [" + kwarg + "]");
+            return false;
+          }
         }
         const int argCount = (int) attr.args.size();
         if (argCount > 1) {
@@ -0,0 +1,62 @@
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/statement.hpp>
+#include <occa/internal/lang/builtins/attributes/reduction.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace attributes {
+      //---[ @reduction ]-----------------------
+      reduction::reduction() {}
+
+      const std::string& reduction::name() const {
+        static std::string name_ = "reduction";
+        return name_;
+      }
+
+      bool reduction::forStatementType(const int sType) const {
+        return (sType & statementType::for_);
+      }
+
+      bool reduction::isValid(const attributeToken_t &attr) const {
+        if (attr.kwargs.size()) {
+          attr.printError("[@reduction] does not take kwargs");
+          return false;
+        }
+
+        const int argCount = (int) attr.args.size();
+        if (argCount < 2) {
+          attr.printError("[@reduction] expects an operator and at least one variable");
+          return false;
+        }
+
+        exprNode *opExpr = attr.args[0].expr;
+        if (!opExpr
+            || !(opExpr->type() & exprNodeType::string)
+            || !isValidOperator(((stringNode*) opExpr)->value)) {
+          attr.printError("[@reduction] operator must be one of"
+                          " \"+\", \"*\", \"&\", \"|\", \"^\", \"&&\", \"||\", \"min\", or \"max\"");
+          return false;
+        }
+
+        for (int i = 1; i < argCount; ++i) {
+          exprNode *varExpr = attr.args[i].expr;
+          if (!varExpr || !(varExpr->type() & exprNodeType::variable)) {
+            attr.printError("[@reduction] can only reduce variables");
+            return false;
+          }
+        }
+        return true;
+      }
+
+      bool reduction::isValidOperator(const std::string &op) {
+        return (
+          (op == "+") || (op == "*")
+          || (op == "&") || (op == "|") || (op == "^")
+          || (op == "&&") || (op == "||")
+          || (op == "min") || (op == "max")
+        );
+      }
+      //==================================
+    }
+  }
+}
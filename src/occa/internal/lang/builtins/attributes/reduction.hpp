@@ -0,0 +1,28 @@
+#ifndef OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_REDUCTION_HEADER
+#define OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_REDUCTION_HEADER
+
+#include <occa/internal/lang/attribute.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace attributes {
+      //---[ @reduction ]---------------
+      // @reduction("+", x, y) on an @outer loop reduces x and y across its iterations
+      class reduction : public attribute_t {
+      public:
+        reduction();
+
+        virtual const std::string& name() const;
+
+        virtual bool forStatementType(const int sType) const;
+
+        virtual bool isValid(const attributeToken_t &attr) const;
+
+        static bool isValidOperator(const std::string &op);
+      };
+      //================================
+    }
+  }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define OCCA_INTERNAL_LANG_FILE_HEADER
 
 #include <iostream>
+#include <memory>
 
 #include <occa/internal/io/output.hpp>
 #include <occa/internal/utils/gc.hpp>
@@ -9,12 +10,19 @@
 
 namespace occa {
   namespace lang {
+    class fileTokens_t;
+
     class file_t : public gc::withRefs {
     public:
       std::string filename;
       std::string expandedFilename;
       std::string content;
 
+      // Tokens read from another include of the same content
+      std::shared_ptr<const fileTokens_t> cachedTokens;
+      // Tokens being read to add to the token cache
+      std::shared_ptr<fileTokens_t> recordedTokens;
+
       file_t(const std::string &filename_);
 
       file_t(const std::string &filename_,
@@ -75,7 +75,10 @@ namespace occa {
       return j;
     }
 
-    sourceMetadata_t::sourceMetadata_t() {}
+    sourceMetadata_t::sourceMetadata_t() :
+      preprocessTime(0),
+      parseTime(0),
+      transformTime(0) {}
 
     json sourceMetadata_t::getKernelMetadataJson() const {
       json metadataJson(json::array_);
@@ -51,6 +51,11 @@ namespace occa {
       kernelMetadataMap kernelsMetadata;
       strHashMap dependencyHashes;
 
+      // Seconds spent translating the source, not stored in build files
+      double preprocessTime;
+      double parseTime;
+      double transformTime;
+
       sourceMetadata_t();
 
       json getKernelMetadataJson() const;
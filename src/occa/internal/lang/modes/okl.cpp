@@ -392,6 +392,8 @@ namespace occa {
         parser.addAttribute<attributes::shared>();
         parser.addAttribute<attributes::maxInnerDims>();
         parser.addAttribute<attributes::noBarrier>();
+        // Only OpenMP lowers @reduction, other backends keep it parseable so kernels stay portable
+        parser.addAttribute<attributes::reduction>();
       }
 
       void setOklLoopIndices(functionDeclStatement &kernelSmnt) {
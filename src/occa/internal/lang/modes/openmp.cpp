@@ -1,12 +1,19 @@
+#include <map>
+#include <set>
+#include <sstream>
+
 #include <occa/internal/lang/modes/openmp.hpp>
-#include <occa/internal/lang/expr/expr.hpp>
+#include <occa/internal/lang/expr.hpp>
 #include <occa/internal/lang/builtins/attributes/atomic.hpp>
 
 namespace occa {
   namespace lang {
     namespace okl {
       openmpParser::openmpParser(const occa::json &settings_) :
-        serialParser(settings_) {}
+        serialParser(settings_) {
+        // The kernels are compiled with OpenMP enabled
+        simdByDefault = true;
+      }
 
       void openmpParser::afterParsing() {
         serialParser::afterParsing();
@@ -16,9 +23,14 @@ namespace occa {
 
         if (!success) return;
         setupAtomics();
+
+        if (!success) return;
+        setupGraphKernels();
       }
 
       void openmpParser::setupOmpPragmas() {
+        graphPragmas.clear();
+
         statementArray outerSmnts = (
           statementArray::from(root)
           .flatFilter([&](statement_t *smnt, const statementArray &path) {
@@ -38,9 +50,26 @@ namespace occa {
             })
         );
 
+        // Reductions become a clause on the [omp parallel for]
+        std::set<statement_t*> pragmaLoops;
+        for (auto outerSmnt : outerSmnts) {
+          pragmaLoops.insert(outerSmnt);
+        }
+        statementArray::from(root)
+          .flatFilterByStatementType(statementType::for_, "reduction")
+          .forEach([&](statement_t *smnt) {
+              if (!pragmaLoops.count(smnt)) {
+                smnt->printError("[@reduction] must be on an outer-most @outer loop");
+                success = false;
+              }
+            });
+        if (!success) return;
+
+        const bool collapsing = settings.get("openmp/collapse", true);
+
         const int count = (int) outerSmnts.length();
         for (int i = 0; i < count; ++i) {
-          statement_t &outerSmnt = *(outerSmnts[i]);
+          forStatement &outerSmnt = (forStatement&) *(outerSmnts[i]);
           statement_t *parent = outerSmnt.up;
           if (!parent
               || !parent->is<blockStatement>()) {
@@ -48,17 +77,172 @@ namespace occa {
             outerSmnt.printError("Unable to add [#pragma omp]");
             return;
           }
+
+          const int collapseCount = (
+            collapsing
+            ? getCollapseCount(outerSmnt)
+            : 1
+          );
+          const std::string clauses = getLoopClauses(outerSmnt, collapseCount);
+          if (!success) return;
+
           // Add OpenMP Pragma
-          blockStatement &outerBlock  = (blockStatement&) outerSmnt;
           blockStatement &parentBlock = *((blockStatement*) parent);
           pragmaStatement *pragmaSmnt = (
             new pragmaStatement((blockStatement*) parent,
-                                pragmaToken(outerBlock.source->origin,
-                                            "omp parallel for"))
+                                pragmaToken(outerSmnt.source->origin,
+                                            "omp parallel for" + clauses))
           );
           parentBlock.addBefore(outerSmnt,
                                 *pragmaSmnt);
+
+          // Team-level clauses and reductions need their own parallel region
+          if (getLoopClauseValue(outerSmnt, "num_threads").empty()
+              && getLoopClauseValue(outerSmnt, "proc_bind").empty()
+              && !outerSmnt.hasAttribute("reduction")) {
+            graphPragmas[pragmaSmnt] = "omp for" + clauses;
+          }
+        }
+      }
+
+      int openmpParser::getCollapseCount(forStatement &outerSmnt) {
+        // Only perfectly nested @outer loops whose bounds don't depend on
+        //   the enclosing loop iterators can be collapsed
+        std::set<variable_t*> loopVariables;
+        forStatement *loopSmnt = &outerSmnt;
+        int collapseCount = 1;
+
+        while (true) {
+          if (loopSmnt->init
+              && (loopSmnt->init->type() & statementType::declaration)) {
+            declarationStatement &declSmnt = (declarationStatement&) *(loopSmnt->init);
+            for (variableDeclaration &decl : declSmnt.declarations) {
+              loopVariables.insert(&(decl.variable()));
+            }
+          }
+
+          if (loopSmnt->children.length() != 1
+              || !isOuterForLoop(loopSmnt->children[0])) {
+            break;
+          }
+
+          forStatement &childSmnt = (forStatement&) *(loopSmnt->children[0]);
+          if (!childSmnt.init || !childSmnt.check || !childSmnt.update) {
+            break;
+          }
+
+          bool isRectangular = true;
+          for (statement_t *smnt : childSmnt.getInnerStatements()) {
+            smnt->getExprNodes()
+              .flatFilterByExprType(exprNodeType::variable)
+              .forEach([&](smntExprNode smntExpr) {
+                  variable_t &var = ((variableNode*) smntExpr.node)->value;
+                  if (loopVariables.count(&var)) {
+                    isRectangular = false;
+                  }
+                });
+          }
+          if (!isRectangular) {
+            break;
+          }
+
+          loopSmnt = &childSmnt;
+          ++collapseCount;
+        }
+
+        return collapseCount;
+      }
+
+      std::string openmpParser::getLoopClauses(forStatement &outerSmnt,
+                                               const int collapseCount) {
+        std::string clauses;
+
+        if (collapseCount > 1) {
+          clauses += " collapse(" + std::to_string(collapseCount) + ")";
+        }
+
+        std::string schedule = getLoopClauseValue(outerSmnt, "schedule");
+        const std::string chunk = getLoopClauseValue(outerSmnt, "chunk");
+        if (schedule.size() || chunk.size()) {
+          // Schedules can have modifiers, such as [nonmonotonic:dynamic]
+          const size_t modifierEnd = schedule.rfind(':');
+          const std::string kind = (
+            (modifierEnd == std::string::npos)
+            ? schedule
+            : schedule.substr(modifierEnd + 1)
+          );
+          if (!schedule.size()) {
+            schedule = "static";
+          } else if (kind != "static" && kind != "dynamic" && kind != "guided"
+                     && kind != "auto" && kind != "runtime") {
+            outerSmnt.printError("[openmp/schedule] must be static, dynamic, guided, auto, or runtime");
+            success = false;
+            return "";
+          }
+
+          clauses += " schedule(" + schedule;
+          if (chunk.size()) {
+            clauses += ", " + chunk;
+          }
+          clauses += ")";
+        }
+
+        const std::string numThreads = getLoopClauseValue(outerSmnt, "num_threads");
+        if (numThreads.size()) {
+          clauses += " num_threads(" + numThreads + ")";
+        }
+
+        const std::string procBind = getLoopClauseValue(outerSmnt, "proc_bind");
+        if (procBind.size()) {
+          if (procBind != "master" && procBind != "primary"
+              && procBind != "close" && procBind != "spread") {
+            outerSmnt.printError("[openmp/proc_bind] must be master, primary, close, or spread");
+            success = false;
+            return "";
+          }
+          clauses += " proc_bind(" + procBind + ")";
         }
+
+        if (outerSmnt.hasAttribute("reduction")) {
+          attributeToken_t &reductionAttr = outerSmnt.attributes["reduction"];
+          const int argCount = (int) reductionAttr.args.size();
+
+          clauses += " reduction(" + ((stringNode*) reductionAttr.args[0].expr)->value + ":";
+          for (int i = 1; i < argCount; ++i) {
+            if (i > 1) {
+              clauses += ", ";
+            }
+            clauses += reductionAttr.args[i].expr->toString();
+          }
+          clauses += ")";
+        }
+
+        return clauses;
+      }
+
+      std::string openmpParser::getLoopClauseValue(forStatement &outerSmnt,
+                                                   const std::string &name) {
+        // @outer(schedule="dynamic") overrides the kernel's openmp/schedule property
+        attributeArg_t *arg = outerSmnt.attributes["outer"][name];
+        if (arg && arg->expr) {
+          if (arg->expr->type() & exprNodeType::string) {
+            return ((stringNode*) arg->expr)->value;
+          }
+          return arg->expr->toString();
+        }
+
+        const std::string settingName = "openmp/" + name;
+        if (!settings.has(settingName)) {
+          return "";
+        }
+        const json &value = settings[settingName];
+        if (value.isString()) {
+          return value.string();
+        }
+        if (value.isNull()) {
+          return "";
+        }
+        return value.toString();
       }
 
       bool openmpParser::isOuterForLoop(statement_t *smnt) {
@@ -69,27 +253,199 @@ namespace occa {
       }
 
       void openmpParser::setupAtomics() {
+        criticalBlocks.clear();
+
         success &= attributes::atomic::applyCodeTransformation(
           root,
-          transformBlockStatement,
+          [&](blockStatement &blockSmnt) {
+            return transformBlockStatement(blockSmnt);
+          },
           transformBasicExpressionStatement
         );
+        if (!success) return;
+
+        setupCriticalSections();
       }
 
       bool openmpParser::transformBlockStatement(blockStatement &blockSmnt) {
-        blockStatement &parent = *(blockSmnt.up);
+        if (blockSmnt.size() == 1
+            && (blockSmnt[0]->type() & statementType::expression)) {
+          expressionStatement &exprSmnt = (expressionStatement&) *blockSmnt[0];
 
-        pragmaStatement &atomicPragmaSmnt = *(
-          new pragmaStatement(&parent,
-                              pragmaToken(blockSmnt.source->origin,
-                                          "omp critical"))
-        );
+          // x = min(x, value) -> occa::atomicMin(&(x), value)
+          std::string functionName;
+          exprNode *argument = NULL;
+          if (attributes::atomic::isMinMaxExpression(exprSmnt, functionName, argument)) {
+            const std::string target = ((binaryOpNode*) exprSmnt.expr)->leftValue->toString();
+            const std::string source = (
+              "occa::atomic" + std::string(functionName == "min" ? "Min" : "Max")
+              + "(&(" + target + "), " + argument->toString() + ");"
+            );
+            exprSmnt.replaceWith(
+              *(new sourceCodeStatement(&blockSmnt,
+                                        exprSmnt.source,
+                                        source))
+            );
+            delete &exprSmnt;
+            return true;
+          }
 
-        parent.addBefore(blockSmnt, atomicPragmaSmnt);
+          // Other updates [omp atomic] supports
+          const opType_t &opType = expr(exprSmnt.expr).opType();
+          if (opType & (
+                operatorType::multEq
+                | operatorType::divEq
+                | operatorType::andEq
+                | operatorType::orEq
+                | operatorType::xorEq
+                | operatorType::leftShiftEq
+                | operatorType::rightShiftEq
+              )) {
+            return transformBasicExpressionStatement(exprSmnt);
+          }
+        }
 
+        criticalBlocks.push_back(&blockSmnt);
         return true;
       }
 
+      void openmpParser::setupCriticalSections() {
+        // Blocks updating the same variables share a named critical section
+        //   so unrelated @atomic blocks don't serialize on the global lock
+        std::map<std::string, std::string> sectionGroups;
+        auto findGroup = [&](const std::string &name) {
+          std::string group = name;
+          while (sectionGroups[group] != group) {
+            group = sectionGroups[group];
+          }
+          return group;
+        };
+
+        const int blockCount = (int) criticalBlocks.size();
+        std::vector<std::set<std::string>> blockTargets(blockCount);
+        bool canNameSections = true;
+        for (int i = 0; i < blockCount; ++i) {
+          std::set<std::string> &targets = blockTargets[i];
+          if (!getAtomicWriteTargets(*criticalBlocks[i], targets)) {
+            canNameSections = false;
+            break;
+          }
+
+          for (const std::string &target : targets) {
+            if (!sectionGroups.count(target)) {
+              sectionGroups[target] = target;
+            }
+          }
+          // Merge the groups of all targets, keeping the smallest name as the root group
+          std::string rootGroup = findGroup(*targets.begin());
+          for (const std::string &target : targets) {
+            const std::string group = findGroup(target);
+            if (group < rootGroup) {
+              sectionGroups[rootGroup] = group;
+              rootGroup = group;
+            } else if (rootGroup < group) {
+              sectionGroups[group] = rootGroup;
+            }
+          }
+        }
+
+        for (int i = 0; i < blockCount; ++i) {
+          blockStatement &blockSmnt = *criticalBlocks[i];
+          blockStatement &parent = *(blockSmnt.up);
+
+          std::string pragma = "omp critical";
+          if (canNameSections) {
+            pragma += "(_occa_atomic_" + findGroup(*blockTargets[i].begin()) + ")";
+          }
+
+          parent.addBefore(
+            blockSmnt,
+            *(new pragmaStatement(&parent,
+                                  pragmaToken(blockSmnt.source->origin,
+                                              pragma)))
+          );
+        }
+      }
+
+      bool openmpParser::getAtomicWriteTargets(blockStatement &blockSmnt,
+                                               std::set<std::string> &targets) {
+        // Targets that could alias other targets can't be named, since
+        //   updates to the same memory would use different sections
+        bool hasKnownTargets = true;
+        statementArray::from(blockSmnt)
+          .flatFilterByExprType(
+            exprNodeType::binary
+            | exprNodeType::leftUnary
+            | exprNodeType::rightUnary
+          )
+          .forEach([&](smntExprNode smntExpr) {
+              exprNode *target = getWrittenExpr(smntExpr.node);
+              if (!target) {
+                return;
+              }
+
+              // Find the variable being indexed, e.g. [a] in [a[i].x]
+              while (true) {
+                if (target->type() & exprNodeType::subscript) {
+                  target = ((subscriptNode*) target)->value;
+                } else if (target->type() & exprNodeType::parentheses) {
+                  target = ((parenthesesNode*) target)->value;
+                } else if ((target->type() & exprNodeType::binary)
+                           && (((binaryOpNode*) target)->opType() & (operatorType::dot
+                                                                     | operatorType::arrow))) {
+                  target = ((binaryOpNode*) target)->leftValue;
+                } else {
+                  break;
+                }
+              }
+
+              variable_t *var = (
+                (target->type() & exprNodeType::variable)
+                ? &(((variableNode*) target)->value)
+                : NULL
+              );
+              if (var && !canAliasAtomicTarget(*smntExpr.smnt, *var)) {
+                targets.insert(var->name());
+              } else {
+                hasKnownTargets = false;
+              }
+            });
+
+        return hasKnownTargets && targets.size();
+      }
+
+      bool openmpParser::canAliasAtomicTarget(statement_t &smnt,
+                                              variable_t &var) {
+        // @restrict arguments are the only way to reach their memory
+        if (var.hasAttribute("restrict")) {
+          return false;
+        }
+        vartype_t &vartype = var.vartype;
+        if (vartype.isReference()
+            || vartype.pointers.size()
+            || (vartype.type && vartype.type->isPointerType())) {
+          return true;
+        }
+        if (!vartype.arrays.size()) {
+          return false;
+        }
+
+        // Local arrays own their memory while array arguments are pointers
+        statement_t *up = &smnt;
+        while (up && !(up->type() & statementType::functionDecl)) {
+          up = up->up;
+        }
+        if (!up) {
+          return false;
+        }
+        for (variable_t *arg : up->to<functionDeclStatement>().function().args) {
+          if (arg == &var) {
+            return true;
+          }
+        }
+        return false;
+      }
+
       bool openmpParser::transformBasicExpressionStatement(expressionStatement &exprSmnt) {
         blockStatement &parent = *(exprSmnt.up);
 
@@ -103,6 +459,86 @@ namespace occa {
 
         return true;
       }
+
+      void openmpParser::setupGraphKernels() {
+        root.children.forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+          if (isGraphKernel(kernelSmnt)) {
+            setupGraphKernel(kernelSmnt);
+          }
+        });
+      }
+
+      bool openmpParser::isGraphKernel(functionDeclStatement &kernelSmnt) {
+        // Every thread of a graph parallel region calls the kernel, so only
+        //   the @outer loops can do work outside of local declarations
+        bool hasOuterLoops = false;
+
+        const int count = (int) kernelSmnt.children.length();
+        for (int i = 0; i < count; ++i) {
+          statement_t *smnt = kernelSmnt.children[i];
+          if (smnt->type() & statementType::pragma) {
+            if (!graphPragmas.count((pragmaStatement*) smnt)) {
+              return false;
+            }
+          } else if (isOuterForLoop(smnt)) {
+            hasOuterLoops = true;
+          } else if (!(smnt->type() & (statementType::declaration
+                                       | statementType::empty))) {
+            return false;
+          }
+        }
+
+        return hasOuterLoops;
+      }
+
+      void openmpParser::setupGraphKernel(functionDeclStatement &kernelSmnt) {
+        // Add a variant whose @outer loops are shared by the threads of the
+        //   enclosing parallel region, along with its packed-argument entry point:
+        //   extern "C" void kernel_occa_graph_launch(void **args)
+        function_t &func = kernelSmnt.function();
+        const std::string kernelName = func.name();
+        const std::string graphKernelName = kernelName + "_occa_graph";
+
+        // Print the kernel with the [omp for] pragmas and the variant name
+        std::vector<std::pair<pragmaStatement*, std::string>> kernelPragmas;
+        const int count = (int) kernelSmnt.children.length();
+        for (int i = 0; i < count; ++i) {
+          statement_t *smnt = kernelSmnt.children[i];
+          if (smnt->type() & statementType::pragma) {
+            pragmaStatement *pragmaSmnt = (pragmaStatement*) smnt;
+            kernelPragmas.push_back({pragmaSmnt, pragmaSmnt->value()});
+            pragmaSmnt->value() = graphPragmas[pragmaSmnt];
+          }
+        }
+        func.source->value = graphKernelName;
+
+        const std::string graphKernelSource = kernelSmnt.toString();
+
+        func.source->value = kernelName;
+        for (auto &kernelPragma : kernelPragmas) {
+          kernelPragma.first->value() = kernelPragma.second;
+        }
+
+        // Without OpenMP, the loops would run in full by each thread
+        std::stringstream ss;
+        ss << "#if defined(_OPENMP)\n"
+           << graphKernelSource << '\n'
+           << "extern \"C\" ";
+#if OCCA_OS == OCCA_WINDOWS_OS
+        ss << "__declspec(dllexport) ";
+#endif
+        ss << "void " << kernelName << graphLaunchFunctionSuffix << "(void **args) {\n"
+           << "  occa::callWithPackedArgs(::" << graphKernelName << ", args);\n"
+           << "}\n"
+           << "#endif";
+
+        kernelSmnt.up->addAfter(
+          kernelSmnt,
+          *(new sourceCodeStatement(kernelSmnt.up,
+                                    kernelSmnt.source,
+                                    ss.str()))
+        );
+      }
     }
   }
 }
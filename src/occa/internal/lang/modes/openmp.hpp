@@ -1,6 +1,10 @@
 #ifndef OCCA_INTERNAL_LANG_MODES_OPENMP_HEADER
 #define OCCA_INTERNAL_LANG_MODES_OPENMP_HEADER
 
+#include <map>
+#include <set>
+#include <vector>
+
 #include <occa/internal/lang/modes/serial.hpp>
 
 namespace occa {
@@ -8,6 +12,11 @@ namespace occa {
     namespace okl {
       class openmpParser : public serialParser {
        public:
+        // @atomic blocks that need a critical section
+        std::vector<blockStatement*> criticalBlocks;
+        // [omp parallel for] pragmas that can become [omp for] inside graph parallel regions
+        std::map<pragmaStatement*, std::string> graphPragmas;
+
         openmpParser(const occa::json &settings_ = occa::json());
 
         virtual void afterParsing();
@@ -16,11 +25,33 @@ namespace occa {
 
         bool isOuterForLoop(statement_t *smnt);
 
+        int getCollapseCount(forStatement &outerSmnt);
+
+        std::string getLoopClauses(forStatement &outerSmnt,
+                                   const int collapseCount);
+
+        std::string getLoopClauseValue(forStatement &outerSmnt,
+                                       const std::string &name);
+
         void setupAtomics();
 
-        static bool transformBlockStatement(blockStatement &blockSmnt);
+        bool transformBlockStatement(blockStatement &blockSmnt);
+
+        void setupCriticalSections();
+
+        bool getAtomicWriteTargets(blockStatement &blockSmnt,
+                                   std::set<std::string> &targets);
+
+        static bool canAliasAtomicTarget(statement_t &smnt,
+                                         variable_t &var);
 
         static bool transformBasicExpressionStatement(expressionStatement &exprSmnt);
+
+        void setupGraphKernels();
+
+        bool isGraphKernel(functionDeclStatement &kernelSmnt);
+
+        void setupGraphKernel(functionDeclStatement &kernelSmnt);
       };
     }
   }
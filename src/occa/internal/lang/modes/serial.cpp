@@ -1,4 +1,5 @@
 #include <set>
+#include <sstream>
 
 #include <occa/internal/lang/modes/serial.hpp>
 #include <occa/internal/lang/modes/okl.hpp>
@@ -9,9 +10,12 @@ namespace occa {
   namespace lang {
     namespace okl {
       const std::string serialParser::exclusiveIndexName = "_occa_exclusive_index";
+      const std::string serialParser::launchFunctionSuffix = "_occa_launch";
+      const std::string serialParser::graphLaunchFunctionSuffix = "_occa_graph_launch";
 
       serialParser::serialParser(const occa::json &settings_) :
-        parser_t(settings_) {
+        parser_t(settings_),
+        simdByDefault(false) {
 
         okl::addOklAttributes(*this);
       }
@@ -29,12 +33,17 @@ namespace occa {
 
         if (!success) return;
         setupExclusives();
+
+        if (!success) return;
+        if (settings.get("okl/simd", simdByDefault)) {
+          setupSimdPragmas();
+        }
       }
 
       void serialParser::setupHeaders() {
         strVector headers;
         const bool includingStd = settings.get("serial/include_std", true);
-        headers.push_back("include <occa.hpp>\n");
+        headers.push_back("include <" + getOccaHeader(settings) + ">\n");
         if (includingStd) {
           headers.push_back("include <stdint.h>");
           headers.push_back("include <cstdlib>");
@@ -60,6 +69,16 @@ namespace occa {
         }
       }
 
+      std::string serialParser::getOccaHeader(const occa::json &settings) {
+        // The kernel prelude only has what generated kernels use, but kernels
+        //   can rely on anything from occa.hpp unless they opt out
+        return (
+          settings.get("serial/include_occa", true)
+          ? "occa.hpp"
+          : "occa/kernelPrelude.hpp"
+        );
+      }
+
       void serialParser::setupKernels() {
         setupHeaders();
         if (!success) return;
@@ -101,6 +120,30 @@ namespace occa {
                                 op::bitAnd);
           type.setReferenceToken(&opToken);
         }
+
+        setupKernelLauncher(kernelSmnt);
+      }
+
+      void serialParser::setupKernelLauncher(functionDeclStatement &kernelSmnt) {
+        // Add a packed-argument entry point to skip the runtime argc switch:
+        //   extern "C" void kernel_occa_launch(void **args)
+        const std::string &kernelName = kernelSmnt.function().name();
+
+        std::stringstream ss;
+        ss << "extern \"C\" ";
+#if OCCA_OS == OCCA_WINDOWS_OS
+        ss << "__declspec(dllexport) ";
+#endif
+        ss << "void " << kernelName << launchFunctionSuffix << "(void **args) {\n"
+           << "  occa::callWithPackedArgs(::" << kernelName << ", args);\n"
+           << "}";
+
+        kernelSmnt.up->addAfter(
+          kernelSmnt,
+          *(new sourceCodeStatement(kernelSmnt.up,
+                                    kernelSmnt.source,
+                                    ss.str()))
+        );
       }
 
       void serialParser::setupExclusives() {
@@ -301,6 +344,126 @@ namespace occa {
                                  expr,
                                  indexVarNode);
       }
+
+      void serialParser::setupSimdPragmas() {
+        // Iterations of an @inner loop are independent, so the inner-most ones
+        //   can be vectorized as long as nothing forces them to run in order
+        statementArray::from(root)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .forEach([&](statement_t *smnt) {
+            const bool hasExclusiveIndex = smnt->hasInScope(exclusiveIndexName);
+            if (!canVectorizeInnerLoop(*smnt, hasExclusiveIndex)) {
+              return;
+            }
+
+            statement_t *parent = smnt->up;
+            if (!parent || !parent->is<blockStatement>()) {
+              return;
+            }
+
+            // The exclusive index is incremented once per iteration
+            std::string pragma = "omp simd";
+            if (hasExclusiveIndex) {
+              pragma += " linear(" + exclusiveIndexName + ":1)";
+            }
+
+            blockStatement &parentBlock = *((blockStatement*) parent);
+            parentBlock.addBefore(
+              *smnt,
+              *(new pragmaStatement(&parentBlock,
+                                    pragmaToken(smnt->source->origin,
+                                                pragma)))
+            );
+          });
+      }
+
+      bool serialParser::canVectorizeInnerLoop(statement_t &innerSmnt,
+                                               const bool hasExclusiveIndex) {
+        int skippedStatementTypes = (
+          statementType::return_
+          | statementType::break_
+          | statementType::goto_
+          | statementType::gotoLabel
+        );
+        // Skipping the exclusive index increment breaks its linear step
+        if (hasExclusiveIndex) {
+          skippedStatementTypes |= statementType::continue_;
+        }
+
+        statementArray blockers = (
+          statementArray::from(innerSmnt)
+          .flatFilter([&](statement_t *smnt) {
+              if (smnt == &innerSmnt) {
+                return false;
+              }
+              return (
+                (smnt->type() & skippedStatementTypes)
+                || ((smnt->type() & statementType::for_) && smnt->hasAttribute("inner"))
+                || smnt->hasAttribute("barrier")
+                || smnt->hasAttribute("atomic")
+              );
+            })
+        );
+
+        if (blockers.length()) {
+          return false;
+        }
+
+        // Variables declared outside the loop are shared by its iterations, so
+        //   writing them is a loop-carried dependence (e.g. [total += a[i]])
+        std::set<variable_t*> loopVariables;
+        statementArray::from(innerSmnt)
+          .nestedForEachDeclaration([&](variableDeclaration &decl) {
+              loopVariables.insert(&(decl.variable()));
+            });
+
+        bool writesSharedVariable = false;
+        statementArray::from(innerSmnt)
+          .flatFilterByExprType(
+            exprNodeType::binary
+            | exprNodeType::leftUnary
+            | exprNodeType::rightUnary
+          )
+          .forEach([&](smntExprNode smntExpr) {
+              exprNode *target = getWrittenExpr(smntExpr.node);
+              while (target && (target->type() & exprNodeType::parentheses)) {
+                target = ((parenthesesNode*) target)->value;
+              }
+              if (!target || !(target->type() & exprNodeType::variable)) {
+                return;
+              }
+
+              variable_t &var = ((variableNode*) target)->value;
+              // The exclusive index is covered by its linear clause
+              if (!loopVariables.count(&var)
+                  && !var.hasAttribute("exclusive")
+                  && (var.name() != exclusiveIndexName)) {
+                writesSharedVariable = true;
+              }
+            });
+
+        return !writesSharedVariable;
+      }
+
+      exprNode* serialParser::getWrittenExpr(exprNode *node) {
+        const opType_t &opType = ((exprOpNode*) node)->opType();
+
+        if (node->type() & exprNodeType::binary) {
+          return (
+            (opType & operatorType::assignment)
+            ? ((binaryOpNode*) node)->leftValue
+            : NULL
+          );
+        }
+        if (!(opType & (operatorType::increment | operatorType::decrement))) {
+          return NULL;
+        }
+        return (
+          (node->type() & exprNodeType::leftUnary)
+          ? ((leftUnaryOpNode*) node)->value
+          : ((rightUnaryOpNode*) node)->value
+        );
+      }
     }
   }
 }
@@ -9,6 +9,12 @@ namespace occa {
       class serialParser : public parser_t {
        public:
         static const std::string exclusiveIndexName;
+        static const std::string launchFunctionSuffix;
+        // Packed entry point of the OpenMP kernel variants used inside graph parallel regions
+        static const std::string graphLaunchFunctionSuffix;
+
+        // Default for the okl/simd setting
+        bool simdByDefault;
 
         serialParser(const occa::json &settings_ = occa::json());
 
@@ -18,9 +24,13 @@ namespace occa {
 
         void setupHeaders();
 
+        // OCCA header included by kernels, which is also the one precompiled
+        static std::string getOccaHeader(const occa::json &settings);
+
         void setupKernels();
 
         static void setupKernel(functionDeclStatement &kernelSmnt);
+        static void setupKernelLauncher(functionDeclStatement &kernelSmnt);
 
         void setupExclusives();
         void setupExclusiveDeclaration(declarationStatement &declSmnt);
@@ -31,6 +41,13 @@ namespace occa {
         exprNode* addExclusiveVariableArrayAccessor(statement_t &smnt,
                                                     exprNode &expr,
                                                     variable_t &var);
+
+        void setupSimdPragmas();
+        bool canVectorizeInnerLoop(statement_t &innerSmnt,
+                                   const bool hasExclusiveIndex);
+
+        // Returns the expression assigned, incremented or decremented by [node], or NULL
+        static exprNode* getWrittenExpr(exprNode *node);
       };
     }
   }
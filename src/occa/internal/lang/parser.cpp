@@ -5,6 +5,7 @@
 #include <occa/internal/lang/variable.hpp>
 #include <occa/internal/lang/builtins/attributes.hpp>
 #include <occa/internal/lang/builtins/types.hpp>
+#include <occa/internal/utils/sys.hpp>
 #include <occa/utils/hash.hpp>
 
 namespace occa {
@@ -22,6 +23,9 @@ namespace occa {
       checkSemicolon(true),
       defaultRootToken(originSource::builtin),
       success(true),
+      preprocessTime(0),
+      parseTime(0),
+      transformTime(0),
       settings(settings_),
       restrictQualifier(NULL) {
       // Properly implement `identifier-nondigit` for identifiers
@@ -108,6 +112,10 @@ namespace occa {
       kernelMetadataMap &metadataMap = sourceMetadata.kernelsMetadata;
       strHashMap &dependencyHashes = sourceMetadata.dependencyHashes;
 
+      sourceMetadata.preprocessTime = preprocessTime;
+      sourceMetadata.parseTime = parseTime;
+      sourceMetadata.transformTime = transformTime;
+
       // Set metadata for all @kernels
       root.children
         .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
@@ -218,6 +226,11 @@ namespace occa {
       clear();
       stream.clearCache();
 
+      const double startTime = sys::currentTime();
+      preprocessTime = 0;
+      parseTime = 0;
+      transformTime = 0;
+
       if (isFile) {
         tokenizer.set(new file_t(source));
       } else {
@@ -233,6 +246,8 @@ namespace occa {
         ? tokenContext[0]->clone()
         : defaultRootToken.clone()
       );
+
+      preprocessTime = sys::currentTime() - startTime;
     }
 
     void parser_t::setupLoadTokens() {
@@ -270,12 +285,17 @@ namespace occa {
     }
 
     void parser_t::parseTokens() {
+      const double startTime = sys::currentTime();
+
       beforeParsing();
       if (!success) return;
 
       loadAllStatements();
       if (!success) return;
 
+      const double parseEndTime = sys::currentTime();
+      parseTime = parseEndTime - startTime;
+
       if (restrictQualifier) {
         success &= attributes::occaRestrict::applyCodeTransformations(root, *restrictQualifier);
         if (!success) return;
@@ -288,6 +308,8 @@ namespace occa {
       if (!success) return;
 
       afterParsing();
+
+      transformTime = sys::currentTime() - parseEndTime;
     }
     //==================================
 
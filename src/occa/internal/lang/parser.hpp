@@ -57,6 +57,11 @@ namespace occa {
       attributeTokenMap attributes;
 
       bool success;
+
+      // Seconds spent in each stage of the last parse
+      double preprocessTime;
+      double parseTime;
+      double transformTime;
       //================================
 
       //---[ Misc ]---------------------
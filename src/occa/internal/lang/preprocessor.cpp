@@ -34,6 +34,7 @@ namespace occa {
       includePaths = env::OCCA_INCLUDE_PATH;
 
       strictHeaders = settings.get("okl/strict_headers", true);
+      cachingIncludes = settings.get("okl/include_cache", true);
 
       json oklIncludePaths = settings["okl/include_paths"];
       if (oklIncludePaths.isArray()) {
@@ -1392,7 +1393,7 @@ namespace occa {
 
       // Push source after updating origin to the [\n] token
       input->clearCache();
-      tokenizer->pushSource(header);
+      tokenizer->pushSource(header, cachingIncludes);
     }
 
     void preprocessor_t::processPragma(identifierToken &directive) {
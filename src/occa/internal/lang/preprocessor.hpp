@@ -45,6 +45,7 @@ namespace occa {
 
       //---[ Settings ]-----------------
       bool strictHeaders;
+      bool cachingIncludes;
       //================================
 
       //---[ Status ]-------------------
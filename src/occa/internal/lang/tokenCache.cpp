@@ -0,0 +1,71 @@
+#include <map>
+#include <mutex>
+
+#include <occa/internal/lang/token.hpp>
+#include <occa/internal/lang/tokenCache.hpp>
+
+namespace occa {
+  namespace lang {
+    fileTokens_t::fileTokens_t(const hash_t &contentHash_) :
+      contentHash(contentHash_) {}
+
+    fileTokens_t::~fileTokens_t() {
+      for (auto &it : tokens) {
+        delete it.second.token;
+      }
+    }
+
+    const cachedToken_t* fileTokens_t::get(const size_t offset) const {
+      auto it = tokens.find(offset);
+      if (it == tokens.end()) {
+        return NULL;
+      }
+      return &(it->second);
+    }
+
+    namespace tokenCache {
+      const size_t maxTokens = (1 << 20);
+
+      namespace {
+        std::mutex cacheMutex;
+        std::map<hash_t, fileTokensPtr> cachedFiles;
+        size_t cachedTokenCount = 0;
+      }
+
+      fileTokensPtr get(const hash_t &contentHash) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        auto it = cachedFiles.find(contentHash);
+        if (it == cachedFiles.end()) {
+          return fileTokensPtr();
+        }
+        return it->second;
+      }
+
+      void add(const std::shared_ptr<fileTokens_t> &fileTokens) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        const size_t tokenCount = fileTokens->tokens.size();
+        if (!tokenCount
+            || (maxTokens < (cachedTokenCount + tokenCount))
+            || cachedFiles.count(fileTokens->contentHash)) {
+          return;
+        }
+
+        cachedFiles[fileTokens->contentHash] = fileTokens;
+        cachedTokenCount += tokenCount;
+      }
+
+      size_t size() {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        return cachedFiles.size();
+      }
+
+      void clear() {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        cachedFiles.clear();
+        cachedTokenCount = 0;
+      }
+    }
+  }
+}
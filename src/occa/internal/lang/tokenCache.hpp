@@ -0,0 +1,60 @@
+#ifndef OCCA_INTERNAL_LANG_TOKENCACHE_HEADER
+#define OCCA_INTERNAL_LANG_TOKENCACHE_HEADER
+
+#include <memory>
+#include <unordered_map>
+
+#include <occa/utils/hash.hpp>
+
+namespace occa {
+  namespace lang {
+    class token_t;
+
+    class cachedToken_t {
+     public:
+      // Stored with a builtin origin, the tokenizer sets the real one when replaying
+      token_t *token;
+
+      // Token position relative to where the tokenizer started reading it
+      size_t originStart, originEnd;
+      size_t originLineStart;
+      int originLineOffset;
+
+      // Tokenizer state after reading the token
+      size_t end;
+      size_t lineStart;
+      int lineOffset;
+    };
+
+    // Tokens of an included file, looked up by the offset where the tokenizer
+    //   started reading them so rewinds and raw reads (e.g. #include headers) still work
+    class fileTokens_t {
+     public:
+      hash_t contentHash;
+      std::unordered_map<size_t, cachedToken_t> tokens;
+
+      fileTokens_t(const hash_t &contentHash_);
+      ~fileTokens_t();
+
+      const cachedToken_t* get(const size_t offset) const;
+    };
+
+    typedef std::shared_ptr<const fileTokens_t> fileTokensPtr;
+
+    // Process-wide cache of tokenized includes, keyed by their content
+    namespace tokenCache {
+      // Stop caching new files after this many tokens
+      extern const size_t maxTokens;
+
+      fileTokensPtr get(const hash_t &contentHash);
+
+      void add(const std::shared_ptr<fileTokens_t> &fileTokens);
+
+      size_t size();
+
+      void clear();
+    }
+  }
+}
+
+#endif
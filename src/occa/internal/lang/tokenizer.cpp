@@ -2,6 +2,7 @@
 #include <occa/internal/utils/string.hpp>
 #include <occa/internal/lang/tokenizer.hpp>
 #include <occa/internal/lang/token.hpp>
+#include <occa/internal/lang/tokenCache.hpp>
 
 namespace occa {
   namespace lang {
@@ -209,7 +210,8 @@ namespace occa {
       }
     }
 
-    void tokenizer_t::pushSource(const std::string &filename) {
+    void tokenizer_t::pushSource(const std::string &filename,
+                                 const bool usingTokenCache) {
       // Delete tokens and rewind
       if (outputCache.size()) {
         origin = outputCache.front()->origin;
@@ -223,6 +225,13 @@ namespace occa {
 
       // TODO: Use a fileCache
       file_t *file = new file_t(filename);
+      if (usingTokenCache) {
+        const hash_t contentHash = occa::hash(file->content);
+        file->cachedTokens = tokenCache::get(contentHash);
+        if (!file->cachedTokens) {
+          file->recordedTokens = std::make_shared<fileTokens_t>(contentHash);
+        }
+      }
       origin.push(true,
                   *file,
                   file->content.c_str());
@@ -231,6 +240,12 @@ namespace occa {
     void tokenizer_t::popSource() {
       OCCA_ERROR("Unable to call tokenizer_t::popSource",
                  origin.up);
+      // Share the tokens once the whole file has been read
+      file_t &file = *(origin.file);
+      if (file.recordedTokens) {
+        tokenCache::add(file.recordedTokens);
+        file.recordedTokens.reset();
+      }
       origin.pop();
     }
 
@@ -589,6 +604,83 @@ namespace occa {
         return new newlineToken(popTokenOrigin());
       }
 
+      file_t &file = *(origin.file);
+      if (file.cachedTokens) {
+        token_t *token = getCachedToken(*file.cachedTokens);
+        if (token) {
+          return token;
+        }
+      }
+      if (!file.recordedTokens) {
+        return getNewToken();
+      }
+
+      const filePosition tokenStart = fp;
+      const int previousErrors = errors;
+
+      token_t *token = getNewToken();
+      // Comments depend on the previous token and errors need to be printed again
+      if (token
+          && (errors == previousErrors)
+          && !(token->type() & tokenType::comment)) {
+        cacheToken(*file.recordedTokens, *token, tokenStart);
+      }
+      return token;
+    }
+
+    token_t* tokenizer_t::getCachedToken(const fileTokens_t &fileTokens) {
+      const char *content = origin.file->content.c_str();
+      const cachedToken_t *cachedToken = fileTokens.get(fp.start - content);
+      if (!cachedToken) {
+        return NULL;
+      }
+
+      fileOrigin tokenOrigin = origin;
+      tokenOrigin.position = filePosition(fp.line + cachedToken->originLineOffset,
+                                          content + cachedToken->originLineStart,
+                                          content + cachedToken->originStart,
+                                          content + cachedToken->originEnd);
+
+      fp.line += cachedToken->lineOffset;
+      fp.lineStart = content + cachedToken->lineStart;
+      fp.start = content + cachedToken->end;
+
+      token_t *token = cachedToken->token->clone();
+      token->origin = tokenOrigin;
+      return token;
+    }
+
+    void tokenizer_t::cacheToken(fileTokens_t &fileTokens,
+                                 token_t &token,
+                                 const filePosition &tokenStart) {
+      const char *content = origin.file->content.c_str();
+      const filePosition &tokenPosition = token.origin.position;
+
+      cachedToken_t cachedToken;
+      cachedToken.originStart = tokenPosition.start - content;
+      cachedToken.originEnd = tokenPosition.end - content;
+      cachedToken.originLineStart = tokenPosition.lineStart - content;
+      cachedToken.originLineOffset = tokenPosition.line - tokenStart.line;
+      cachedToken.end = fp.start - content;
+      cachedToken.lineStart = fp.lineStart - content;
+      cachedToken.lineOffset = fp.line - tokenStart.line;
+
+      // Avoid sharing the file between threads through the cached token
+      cachedToken.token = token.clone();
+      cachedToken.token->origin = fileOrigin(originSource::builtin);
+
+      // Rewinds read the same tokens again
+      const size_t offset = tokenStart.start - content;
+      auto it = fileTokens.tokens.find(offset);
+      if (it != fileTokens.tokens.end()) {
+        delete it->second.token;
+        it->second = cachedToken;
+      } else {
+        fileTokens.tokens[offset] = cachedToken;
+      }
+    }
+
+    token_t* tokenizer_t::getNewToken() {
       int type = peek();
       if (type & tokenType::identifier) {
         return getIdentifierToken();
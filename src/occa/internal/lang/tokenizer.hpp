@@ -73,7 +73,8 @@ namespace occa {
       virtual bool isEmpty();
       virtual void setNext(token_t *&out);
 
-      void pushSource(const std::string &filename);
+      void pushSource(const std::string &filename,
+                      const bool usingTokenCache = false);
       void popSource();
 
       void push();
@@ -103,6 +104,11 @@ namespace occa {
       void getRawString(std::string &value);
 
       token_t* getToken();
+      token_t* getCachedToken(const fileTokens_t &fileTokens);
+      void cacheToken(fileTokens_t &fileTokens,
+                      token_t &token,
+                      const filePosition &tokenStart);
+      token_t* getNewToken();
       token_t* getIdentifierToken();
       token_t* getPrimitiveToken();
       token_t* getOperatorToken();
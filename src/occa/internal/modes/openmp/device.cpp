@@ -18,13 +18,6 @@ namespace occa {
       );
     }
 
-    hash_t device::kernelHash(const occa::json &props) const {
-      return (
-        serial::device::kernelHash(props)
-        ^ occa::hash("openmp")
-      );
-    }
-
     bool device::parseFile(const std::string &filename,
                            const std::string &outputFile,
                            const occa::json &kernelProps,
@@ -54,12 +47,9 @@ namespace occa {
       return true;
     }
 
-    modeKernel_t* device::buildKernel(const std::string &filename,
-                                      const std::string &kernelName,
-                                      const hash_t kernelHash,
-                                      const occa::json &kernelProps) {
-
-      occa::json allKernelProps = properties + kernelProps;
+    bool device::setupOpenMPKernelProps(const occa::json &kernelProps,
+                                        occa::json &allKernelProps) {
+      allKernelProps = properties + kernelProps;
 
       std::string compilerLanguage;
       compilerLanguage = "cpp";
@@ -122,6 +112,15 @@ namespace occa {
       if (usingOpenMP) {
         allKernelProps["compiler_flags"] += " " + lastCompilerOpenMPFlag;
       }
+      return usingOpenMP;
+    }
+
+    modeKernel_t* device::buildKernel(const std::string &filename,
+                                      const std::string &kernelName,
+                                      const hash_t kernelHash,
+                                      const occa::json &kernelProps) {
+      occa::json allKernelProps;
+      const bool usingOpenMP = setupOpenMPKernelProps(kernelProps, allKernelProps);
 
       modeKernel_t *k = serial::device::buildKernel(filename,
                                                     kernelName,
@@ -136,5 +135,29 @@ namespace occa {
 
       return k;
     }
+
+    void device::buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                              const int jobs) {
+      std::vector<bool> usingOpenMP;
+      for (kernelBuildRequest_t &request : requests) {
+        occa::json allKernelProps;
+        usingOpenMP.push_back(
+          setupOpenMPKernelProps(request.kernelProps, allKernelProps)
+        );
+        request.kernelProps = allKernelProps;
+      }
+
+      serial::device::buildKernels(requests, jobs);
+
+      const int requestCount = (int) requests.size();
+      for (int i = 0; i < requestCount; ++i) {
+        modeKernel_t *k = requests[i].modeKernel;
+        if (k && usingOpenMP[i]) {
+          k->modeDevice->removeKernelRef(k);
+          k->modeDevice = this;
+          addKernelRef(k);
+        }
+      }
+    }
   }
 }
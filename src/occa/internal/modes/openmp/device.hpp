@@ -17,17 +17,22 @@ namespace occa {
 
       virtual hash_t hash() const;
 
-      virtual hash_t kernelHash(const occa::json &props) const;
-
       virtual bool parseFile(const std::string &filename,
                              const std::string &outputFile,
                              const occa::json &kernelProps,
                              lang::sourceMetadata_t &metadata);
 
+      // Returns true if the compiler supports OpenMP
+      bool setupOpenMPKernelProps(const occa::json &kernelProps,
+                                  occa::json &allKernelProps);
+
       virtual modeKernel_t* buildKernel(const std::string &filename,
                                         const std::string &kernelName,
                                         const hash_t kernelHash,
                                         const occa::json &kernelProps);
+
+      virtual void buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                                const int jobs);
     };
   }
 }
@@ -12,6 +12,10 @@ namespace occa {
       occa::modeBuffer_t(modeDevice_, size_, properties_) {}
 
     buffer::~buffer() {
+      // Queued async copies and launches may still reference the buffer
+      if (modeDevice) {
+        modeDevice->finishAll();
+      }
 
       if (!isWrapped && ptr) {
         if (properties.get("use_host_pointer", false)) {
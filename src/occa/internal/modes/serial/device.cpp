@@ -1,10 +1,18 @@
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/lex.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/internal/utils/compileServer.hpp>
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
 #include <occa/internal/modes/serial/buffer.hpp>
+#include <occa/internal/modes/serial/graph.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
 #include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/modes/serial/streamTag.hpp>
@@ -12,6 +20,116 @@
 
 namespace occa {
   namespace serial {
+    namespace {
+      // Literal defines can stay as macros in the translated source
+      bool isSymbolicDefine(const occa::json &value) {
+        return value.isNumber() || value.isBool();
+      }
+
+      bool isIdentifierChar(const char c) {
+        return lex::isAlpha(c) || lex::isDigit(c) || (c == '_');
+      }
+
+      std::string readIdentifier(const char *&c) {
+        const char *start = c;
+        while (isIdentifierChar(*c)) {
+          ++c;
+        }
+        return std::string(start, c - start);
+      }
+
+      bool usesNames(const char *c,
+                     const std::set<std::string> &names) {
+        while (*c) {
+          if (!isIdentifierChar(*c)) {
+            ++c;
+            continue;
+          }
+          if (names.count(readIdentifier(c))) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      // Returns the directive of a preprocessor line, leaving [c] after it
+      std::string readDirective(const char *&c) {
+        lex::skipWhitespace(c);
+        if (*c != '#') {
+          return "";
+        }
+        ++c;
+        lex::skipWhitespace(c);
+        return readIdentifier(c);
+      }
+
+      // Adds macros whose expansion uses [names], such as M in [#define M (N * 2)]
+      void addDependentMacros(const std::string &source,
+                              std::set<std::string> &names) {
+        // Macros can use macros defined after them, so repeat until nothing is added
+        bool addedNames = true;
+        while (addedNames) {
+          addedNames = false;
+
+          std::stringstream ss(source);
+          std::string line;
+          while (std::getline(ss, line)) {
+            const char *c = line.c_str();
+            if (readDirective(c) != "define") {
+              continue;
+            }
+            lex::skipWhitespace(c);
+            const std::string macroName = readIdentifier(c);
+            if (macroName.size() && !names.count(macroName) && usesNames(c, names)) {
+              names.insert(macroName);
+              addedNames = true;
+            }
+          }
+        }
+      }
+
+      // Checks for symbolic defines that need to be expanded during translation, such as
+      //   ones used in preprocessor conditionals or @tile sizes, directly or through other macros
+      bool needsExpandedDefines(const std::string &source,
+                                const std::set<std::string> &defineNames) {
+        std::set<std::string> names = defineNames;
+        addDependentMacros(source, names);
+
+        std::stringstream ss(source);
+        std::string line;
+        while (std::getline(ss, line)) {
+          const char *c = line.c_str();
+          const std::string directive = readDirective(c);
+          if (directive.size()) {
+            if ((directive != "if") && (directive != "ifdef") &&
+                (directive != "ifndef") && (directive != "elif")) {
+              continue;
+            }
+          } else if (line.find("@tile") == std::string::npos) {
+            continue;
+          }
+
+          if (usesNames(c, names)) {
+            return true;
+          }
+        }
+        return false;
+      }
+    }
+
+    kernelBuild_t::kernelBuild_t(const std::string &filename_,
+                                 const std::string &kernelName_,
+                                 const hash_t &kernelHash_,
+                                 const occa::json &kernelProps_,
+                                 const bool isLauncherKernel_) :
+      filename(filename_),
+      kernelName(kernelName_),
+      kernelHash(kernelHash_),
+      kernelProps(kernelProps_),
+      isLauncherKernel(isLauncherKernel_),
+      foundBinary(false),
+      compileTime(0) {}
+
     device::device(const occa::json &properties_) :
       occa::modeDevice_t(properties_) {}
 
@@ -37,6 +155,7 @@ namespace occa {
         ^ props["compiler_language"]
         ^ props["compiler_linker_flags"]
         ^ props["compiler_shared_flags"]
+        ^ props["serial/include_occa"]
       );
     }
 
@@ -50,10 +169,26 @@ namespace occa {
     }
 
     occa::streamTag device::tagStream() {
-      return new occa::serial::streamTag(this, sys::currentTime());
+      stream *s = getStream(this);
+      if (!s || !s->isAsync()) {
+        return new occa::serial::streamTag(this, sys::currentTime());
+      }
+
+      // Record the time the tag is reached by the stream worker, not the enqueue time
+      std::shared_ptr<std::promise<double>> tagTime = std::make_shared<std::promise<double>>();
+      occa::streamTag tag = new occa::serial::streamTag(this, tagTime->get_future().share());
+      s->enqueue([tagTime]() {
+        tagTime->set_value(sys::currentTime());
+      });
+      return tag;
     }
 
-    void device::waitFor(occa::streamTag tag) {}
+    void device::waitFor(occa::streamTag tag) {
+      occa::serial::streamTag *srTag = (
+        dynamic_cast<occa::serial::streamTag*>(tag.getModeStreamTag())
+      );
+      srTag->wait();
+    }
 
     double device::timeBetween(const occa::streamTag &startTag,
                                const occa::streamTag &endTag) {
@@ -64,7 +199,13 @@ namespace occa {
         dynamic_cast<occa::serial::streamTag*>(endTag.getModeStreamTag())
       );
 
-      return (srEndTag->time - srStartTag->time);
+      return (srEndTag->getTime() - srStartTag->getTime());
+    }
+    //==================================
+
+    //---[ Graph ]----------------------
+    modeGraph_t* device::createGraph() {
+      return new graph(this);
     }
     //==================================
 
@@ -97,6 +238,113 @@ namespace occa {
       return true;
     }
 
+    bool device::parseFileWithSymbolicDefines(const std::string &filename,
+                                              const std::string &rawSourceFilename,
+                                              const std::string &outputFile,
+                                              const occa::json &kernelProps,
+                                              lang::sourceMetadata_t &metadata) {
+      occa::json translationProps = kernelProps;
+      occa::json symbolicProps;
+      std::set<std::string> defineNames;
+
+      for (const auto &entry : kernelProps["defines"].object()) {
+        if (isSymbolicDefine(entry.second)) {
+          defineNames.insert(entry.first);
+          symbolicProps["defines"][entry.first] = entry.second;
+          translationProps["defines"].remove(entry.first.c_str());
+        }
+      }
+
+      // String defines stay in the translation and can use symbolic ones
+      const std::string translationHeader = assembleKernelHeader(translationProps);
+      const std::string source = io::read(filename);
+      if (defineNames.empty() ||
+          needsExpandedDefines(translationHeader + source, defineNames)) {
+        return parseFile(rawSourceFilename, outputFile, kernelProps, metadata);
+      }
+
+      // Symbolic array sizes can't be validated until the backend compiles them
+      translationProps["okl/validate"] = false;
+      // The kernel hash includes the define values
+      translationProps.remove("hash");
+
+      hash_t translationHash = (
+        occa::hashFile(filename)
+        ^ translationProps.hash()
+        ^ occa::hash(mode)
+      );
+      for (const std::string &defineName : defineNames) {
+        translationHash ^= occa::hash(defineName);
+      }
+
+      const std::string translationDir = io::hashDir(translationHash);
+      const std::string translatedFile = translationDir + kc::sourceFile;
+      const std::string translationBuildFile = translationDir + kc::buildFile;
+
+      bool foundTranslation = (
+        io::isFile(translatedFile)
+        && io::isFile(translationBuildFile)
+      );
+      if (foundTranslation) {
+        metadata = lang::sourceMetadata_t::fromBuildFile(translationBuildFile);
+
+        // Included files could have changed since they were translated
+        for (const auto &it : metadata.dependencyHashes) {
+          if (!io::isFile(it.first) || (occa::hashFile(it.first) != it.second)) {
+            foundTranslation = false;
+            break;
+          }
+        }
+      }
+
+      if (!foundTranslation) {
+        const std::string translationSource = translationDir + io::basename(rawSourceFilename);
+        io::stageFile(
+          translationSource,
+          true,
+          [&](const std::string &tempFilename) -> bool {
+            io::write(tempFilename, translationHeader + source);
+            return true;
+          }
+        );
+
+        metadata = lang::sourceMetadata_t();
+        if (!parseFile(translationSource, translatedFile, translationProps, metadata)) {
+          return false;
+        }
+
+        // Included files can use the defines or define macros used by the kernel source
+        std::string fullSource = translationHeader;
+        for (const auto &it : metadata.dependencyHashes) {
+          fullSource += io::read(it.first) + "\n";
+        }
+        fullSource += source;
+        if (metadata.dependencyHashes.size() &&
+            needsExpandedDefines(fullSource, defineNames)) {
+          // Skip writing the build file so the translation is never reused
+          metadata = lang::sourceMetadata_t();
+          return parseFile(rawSourceFilename, outputFile, kernelProps, metadata);
+        }
+
+        writeKernelBuildFile(translationBuildFile,
+                             translationHash,
+                             translationProps,
+                             metadata);
+      }
+
+      io::stageFile(
+        outputFile,
+        true,
+        [&](const std::string &tempFilename) -> bool {
+          io::write(tempFilename,
+                    assembleKernelHeader(symbolicProps) + io::read(translatedFile));
+          return true;
+        }
+      );
+
+      return true;
+    }
+
     // TODO: Functionally obsolete overload? kernelProps from the device will now be empty anyway.
     modeKernel_t* device::buildKernel(const std::string &filename,
                                       const std::string &kernelName,
@@ -116,6 +364,102 @@ namespace occa {
                                       const hash_t kernelHash,
                                       const occa::json &kernelProps,
                                       const bool isLauncherKernel) {
+      kernelBuild_t build(filename, kernelName, kernelHash, kernelProps, isLauncherKernel);
+
+      if (!prepareKernelBuild(build)) {
+        return NULL;
+      }
+      if (!build.foundBinary) {
+        compileKernelBuild(build);
+        build.lock->release();
+      }
+      return loadKernelBuild(build);
+    }
+
+    void device::buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                              const int jobs) {
+      const int requestCount = (int) requests.size();
+
+      std::vector<kernelBuild_t> builds;
+      builds.reserve(requestCount);
+      for (kernelBuildRequest_t &request : requests) {
+        builds.push_back(
+          kernelBuild_t(request.filename,
+                        request.kernelName,
+                        request.kernelHash,
+                        request.kernelProps,
+                        false)
+        );
+      }
+
+      // OKL translation is kept on the calling thread since the parser is not thread-safe
+      std::vector<bool> prepared(requestCount, false);
+      std::vector<int> compileIndices;
+      std::vector<int> lockedIndices;
+      std::set<std::string> compiledBinaries;
+      for (int i = 0; i < requestCount; ++i) {
+        kernelBuild_t &build = builds[i];
+
+        // Kernels from the same source and props share a single binary
+        const std::string binaryFilename = (
+          io::hashDir(build.filename, build.kernelHash) + kc::binaryFile
+        );
+        if (compiledBinaries.count(binaryFilename)) {
+          lockedIndices.push_back(i);
+          continue;
+        }
+
+        // Binaries being built by other processes are waited on after our own compilations
+        if (!io::isFile(binaryFilename)) {
+          build.lock = std::make_shared<io::lock_t>(build.kernelHash, kc::binaryFile);
+          if (!build.lock->tryAcquire()) {
+            lockedIndices.push_back(i);
+            continue;
+          }
+        }
+
+        prepared[i] = prepareKernelBuild(build);
+        if (!prepared[i] || build.foundBinary) {
+          continue;
+        }
+        compiledBinaries.insert(build.binaryFilename);
+        compileIndices.push_back(i);
+      }
+
+      sys::parallelFor(
+        (int) compileIndices.size(),
+        jobs,
+        [&](const int taskIndex) {
+          kernelBuild_t &build = builds[compileIndices[taskIndex]];
+          compileKernelBuild(build);
+          build.lock->release();
+        }
+      );
+
+      for (const int i : lockedIndices) {
+        kernelBuild_t &build = builds[i];
+        prepared[i] = prepareKernelBuild(build);
+        if (prepared[i] && !build.foundBinary) {
+          compileKernelBuild(build);
+          build.lock->release();
+        }
+      }
+
+      for (int i = 0; i < requestCount; ++i) {
+        requests[i].modeKernel = (
+          prepared[i]
+          ? loadKernelBuild(builds[i])
+          : NULL
+        );
+      }
+    }
+
+    bool device::prepareKernelBuild(kernelBuild_t &build) {
+      const std::string &filename = build.filename;
+      const hash_t &kernelHash = build.kernelHash;
+      const occa::json &kernelProps = build.kernelProps;
+      const bool isLauncherKernel = build.isLauncherKernel;
+
       const std::string hashDir = io::hashDir(filename, kernelHash);
 
       const std::string &kcBinaryFile = (
@@ -126,32 +470,29 @@ namespace occa {
       std::string binaryFilename = hashDir + kcBinaryFile;
 
       // Check if binary exists and is finished
-      const bool foundBinary = io::isFile(binaryFilename);
+      build.binaryFilename = binaryFilename;
+      build.foundBinary = io::isFile(binaryFilename);
+      if (build.foundBinary) {
+        return true;
+      }
 
-      const bool verbose = kernelProps.get("verbose", false);
-      if (foundBinary) {
-        if (verbose) {
-          io::stdout << "Loading cached ["
-                     << kernelName
-                     << "] from ["
-                     << filename
-                     << "] in [" << binaryFilename << "]\n";
-        }
-        modeKernel_t *k = buildKernelFromBinary(binaryFilename,
-                                                kernelName,
-                                                kernelProps);
-        if (k) {
-          k->sourceFilename = filename;
-        }
-        return k;
+      // Only one process builds each binary, the others wait and load it
+      if (!build.lock) {
+        build.lock = std::make_shared<io::lock_t>(kernelHash, kcBinaryFile);
+      }
+      build.lock->acquire();
+      build.foundBinary = io::isFile(binaryFilename);
+      if (build.foundBinary) {
+        build.lock->release();
+        return true;
       }
 
       std::string compilerLanguage;
-      std::string compiler;
-      std::string compilerFlags;
-      std::string compilerLinkerFlags;
+      std::string &compiler = build.compiler;
+      std::string &compilerFlags = build.compilerFlags;
+      std::string &compilerLinkerFlags = build.compilerLinkerFlags;
       std::string compilerSharedFlags;
-      std::string compilerEnvScript;
+      std::string &compilerEnvScript = build.compilerEnvScript;
 
       // Default to C++
       compilerLanguage = "cpp";
@@ -266,8 +607,8 @@ namespace occa {
         sys::addCompilerFlags(compilerFlags, sys::compilerC99Flags(compilerVendor));
       }
 
-      std::string sourceFilename;
-      lang::sourceMetadata_t metadata;
+      std::string &sourceFilename = build.sourceFilename;
+      lang::sourceMetadata_t &metadata = build.metadata;
 
       if (isLauncherKernel) {
         sourceFilename = filename;
@@ -288,12 +629,21 @@ namespace occa {
 
         if (compilingOkl) {
           const std::string outputFile = hashDir + kc::sourceFile;
-          bool valid = parseFile(sourceFilename,
-                                 outputFile,
-                                 kernelProps,
-                                 metadata);
+          bool valid = (
+            kernelProps.get("okl/symbolic_defines", false)
+            ? parseFileWithSymbolicDefines(filename,
+                                           sourceFilename,
+                                           outputFile,
+                                           kernelProps,
+                                           metadata)
+            : parseFile(sourceFilename,
+                        outputFile,
+                        kernelProps,
+                        metadata)
+          );
           if (!valid) {
-            return NULL;
+            build.lock->release();
+            return false;
           }
           sourceFilename = outputFile;
 
@@ -304,50 +654,271 @@ namespace occa {
         }
       }
 
-      std::stringstream command;
-      if (compilerEnvScript.size()) {
-        command << compilerEnvScript << " && ";
-      }
-
       sys::addCompilerFlags(compilerFlags, compilerSharedFlags);
 
+      if (compilingOkl && !isLauncherKernel &&
+          kernelProps.get("precompiled_header", true)) {
+        const std::string preludeHeader = getPrecompiledPrelude(build, compilerVendor);
+        if (preludeHeader.size()) {
+          compilerFlags += " -include " + preludeHeader;
+        }
+      }
+
       if (!compilingOkl) {
         sys::addCompilerIncludeFlags(compilerFlags);
         sys::addCompilerLibraryFlags(compilerFlags);
       }
 
-      io::stageFile(
-        binaryFilename,
-        true,
-        [&](const std::string &tempFilename) -> bool {
+      return true;
+    }
+
+    std::string device::getPrecompiledPrelude(const kernelBuild_t &build,
+                                              const int compilerVendor) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      // GCC picks up [header].gch and Clang picks up [header].pch when force-including [header]
+      if (!(compilerVendor & (sys::vendor::GNU | sys::vendor::LLVM))) {
+        return "";
+      }
+
+      std::string headerSource;
+      if (build.kernelProps.get("serial/include_std", true)) {
+        headerSource += (
+          "#include <stdint.h>\n"
+          "#include <cstdlib>\n"
+          "#include <cstdio>\n"
+          "#include <cmath>\n"
+        );
+      }
+      headerSource += "#include <" + lang::okl::serialParser::getOccaHeader(build.kernelProps) + ">\n";
+
+      const hash_t headerHash = (
+        occa::hash(headerSource)
+        ^ occa::hash(build.compiler)
+        ^ occa::hash(build.compilerFlags)
+        ^ occa::hash(build.compilerEnvScript)
+      );
+      const std::string headerDir = io::hashDir(headerHash);
+      const std::string headerFilename = headerDir + kc::preludeHeaderFile;
+      const std::string binaryFilename = headerFilename + (
+        (compilerVendor & sys::vendor::GNU)
+        ? ".gch"
+        : ".pch"
+      );
+      const std::string buildFilename = headerDir + kc::buildFile;
+
+      // Only check the header dependencies once per process
+      static std::mutex preludeMutex;
+      static std::set<std::string> validPreludes;
+      std::lock_guard<std::mutex> lock(preludeMutex);
+
+      // The cache directory can be cleared while the process runs
+      if (validPreludes.count(headerFilename)) {
+        if (io::isFile(headerFilename) && io::isFile(binaryFilename)) {
+          return headerFilename;
+        }
+        validPreludes.erase(headerFilename);
+      }
+
+      // Precompiled headers don't check if the headers they were built from changed
+      bool isValid = io::isFile(binaryFilename) && io::isFile(buildFilename);
+      if (isValid) {
+        occa::json dependencies = occa::json::read(buildFilename)["dependencies"];
+        for (const auto &entry : dependencies.object()) {
+          if (!io::isFile(entry.first) ||
+              (occa::hashFile(entry.first) != hash_t::fromString(entry.second))) {
+            isValid = false;
+            break;
+          }
+        }
+      }
+
+      if (!isValid) {
+        io::stageFile(
+          headerFilename,
+          false,
+          [&](const std::string &tempFilename) -> bool {
+            io::write(tempFilename, headerSource);
+            return true;
+          }
+        );
+
+        strVector dependencyFilenames;
+        io::stageFile(
+          binaryFilename,
+          false,
+          [&](const std::string &tempFilename) -> bool {
+            const std::string dependencyFilename = tempFilename + ".d";
+
+            std::stringstream command;
+            if (build.compilerEnvScript.size()) {
+              command << build.compilerEnvScript << " && ";
+            }
+            command << build.compiler
+                    << ' '    << build.compilerFlags
+                    << " -x c++-header " << headerFilename
+                    << " -o " << tempFilename
+                    << " -MD -MF " << dependencyFilename
+                    << " -I"  << env::OCCA_DIR << "include"
+                    << " -I"  << env::OCCA_INSTALL_DIR << "include"
+                    << " 2>&1";
+
+            const std::string sCommand = command.str();
+            if (build.kernelProps.get("verbose", false)) {
+              io::stdout << "Compiling [kernel prelude]\n" << sCommand << "\n";
+            }
+
+            std::string commandOutput;
+            if (sys::call(sCommand.c_str(), commandOutput)) {
+              // Kernels still compile without the precompiled header
+              if (build.kernelProps.get("verbose", false)) {
+                io::stdout << "Unable to precompile kernel prelude:\n" << commandOutput << "\n";
+              }
+              sys::rmrf(dependencyFilename);
+              return false;
+            }
+
+            // Make rules are formatted as [target: dep1 dep2 \ dep3]
+            const std::string rules = io::read(dependencyFilename);
+            sys::rmrf(dependencyFilename);
+
+            std::string dependency;
+            const int chars = (int) rules.size();
+            for (int i = 0; i <= chars; ++i) {
+              const char c = (i < chars) ? rules[i] : ' ';
+              if ((c == '\\') && (i + 1 < chars) && (rules[i + 1] == ' ')) {
+                dependency += ' ';
+                ++i;
+              } else if ((c == '\\') || lex::isWhitespace(c)) {
+                if (dependency.size() && (dependency.back() != ':')) {
+                  dependencyFilenames.push_back(dependency);
+                }
+                dependency.clear();
+              } else {
+                dependency += c;
+              }
+            }
+            return true;
+          }
+        );
+
+        if (!io::isFile(binaryFilename) || dependencyFilenames.empty()) {
+          return "";
+        }
+
+        occa::json dependencies;
+        for (const std::string &dependencyFilename : dependencyFilenames) {
+          dependencies.set(dependencyFilename,
+                           occa::hashFile(dependencyFilename).getFullString());
+        }
+        occa::json info;
+        info["dependencies"] = dependencies;
+        io::stageFile(
+          buildFilename,
+          false,
+          [&](const std::string &tempFilename) -> bool {
+            info.write(tempFilename);
+            return true;
+          }
+        );
+      }
+
+      validPreludes.insert(headerFilename);
+      return headerFilename;
+#else
+      return "";
+#endif
+    }
+
+    void device::compileKernelBuild(kernelBuild_t &build) {
+      const std::string &kernelName = build.kernelName;
+      const occa::json &kernelProps = build.kernelProps;
+      const std::string &compiler = build.compiler;
+      const std::string &compilerFlags = build.compilerFlags;
+      const std::string &compilerLinkerFlags = build.compilerLinkerFlags;
+      const std::string &sourceFilename = build.sourceFilename;
+
+      const bool verbose = kernelProps.get("verbose", false);
+      const double startTime = sys::currentTime();
+
+      auto getCommand = [&](const std::string &outputFilename) -> std::string {
+        std::stringstream command;
+        if (build.compilerEnvScript.size()) {
+          command << build.compilerEnvScript << " && ";
+        }
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-          command << compiler
-                  << ' '    << compilerFlags
-                  << ' '    << sourceFilename
-                  << " -o " << tempFilename
-                  << " -I"  << env::OCCA_DIR << "include"
-                  << " -I"  << env::OCCA_INSTALL_DIR << "include"
-                  << " -L"  << env::OCCA_INSTALL_DIR << "lib -locca"
-                  << ' '    << compilerLinkerFlags
-                  << " 2>&1"
-                  << std::endl;
+        command << compiler
+                << ' '    << compilerFlags
+                << ' '    << sourceFilename
+                << " -o " << outputFilename
+                << " -I"  << env::OCCA_DIR << "include"
+                << " -I"  << env::OCCA_INSTALL_DIR << "include"
+                << " -L"  << env::OCCA_INSTALL_DIR << "lib -locca"
+                << ' '    << compilerLinkerFlags
+                << " 2>&1"
+                << std::endl;
 #else
-          command << kernelProps["compiler"]
-                  << " /D MC_CL_EXE"
-                  << " /D OCCA_OS=OCCA_WINDOWS_OS"
-                  << " /EHsc"
-                  << " /wd4244 /wd4800 /wd4804 /wd4018"
-                  << ' '       << compilerFlags
-                  << " /I"     << env::OCCA_DIR << "include"
-                  << " /I"     << env::OCCA_INSTALL_DIR << "include"
-                  << ' '       << sourceFilename
-                  << " /link " << env::OCCA_INSTALL_DIR << "lib/libocca.lib",
-                  << ' '       << compilerLinkerFlags
-                  << " /OUT:"  << tempFilename
-                  << std::endl;
+        command << kernelProps["compiler"]
+                << " /D MC_CL_EXE"
+                << " /D OCCA_OS=OCCA_WINDOWS_OS"
+                << " /EHsc"
+                << " /wd4244 /wd4800 /wd4804 /wd4018"
+                << ' '       << compilerFlags
+                << " /I"     << env::OCCA_DIR << "include"
+                << " /I"     << env::OCCA_INSTALL_DIR << "include"
+                << ' '       << sourceFilename
+                << " /link " << env::OCCA_INSTALL_DIR << "lib/libocca.lib",
+                << ' '       << compilerLinkerFlags
+                << " /OUT:"  << outputFilename
+                << std::endl;
 #endif
+        return strip(command.str());
+      };
+
+      auto checkExitCode = [&](const int commandExitCode,
+                               const std::string &sCommand,
+                               const std::string &commandOutput) {
+        if (commandExitCode) {
+          OCCA_FORCE_ERROR(
+            "Error compiling [" << kernelName << "],"
+            " Command: [" << sCommand << "]\n"
+            << "Output:\n\n"
+            << commandOutput << "\n"
+          );
+        }
+      };
+
+      // Processes on the same node share one compilation through the compile server
+      const std::string compileServerSocket = compileServer::getSocketPath(kernelProps);
+      if (compileServerSocket.size() && !io::isFile(build.binaryFilename)) {
+        const std::string sCommand = getCommand(compileServer::outputPlaceholder);
+        if (verbose) {
+          io::stdout << "Compiling [" << kernelName << "]"
+                     << " with compile server [" << compileServerSocket << "]\n"
+                     << sCommand << "\n";
+        }
+
+        int commandExitCode;
+        std::string commandOutput;
+        if (compileServer::compile(compileServerSocket,
+                                   build.binaryFilename,
+                                   sCommand,
+                                   commandExitCode,
+                                   commandOutput)) {
+          checkExitCode(commandExitCode, sCommand, commandOutput);
+          build.compileTime = sys::currentTime() - startTime;
+          return;
+        }
+        // Compile locally if the server isn't running
+        if (verbose) {
+          io::stdout << "Unable to reach compile server [" << compileServerSocket << "]\n";
+        }
+      }
 
-          const std::string &sCommand = strip(command.str());
+      io::stageFile(
+        build.binaryFilename,
+        true,
+        [&](const std::string &tempFilename) -> bool {
+          const std::string sCommand = getCommand(tempFilename);
           if (verbose) {
             io::stdout << "Compiling [" << kernelName << "]\n" << sCommand << "\n";
           }
@@ -364,26 +935,46 @@ namespace occa {
             commandOutput
           );
 #endif
-
-          if (commandExitCode) {
-            OCCA_FORCE_ERROR(
-              "Error compiling [" << kernelName << "],"
-              " Command: [" << sCommand << "]\n"
-              << "Output:\n\n"
-              << commandOutput << "\n"
-            );
-          }
+          checkExitCode(commandExitCode, sCommand, commandOutput);
 
           return true;
         }
       );
+      build.compileTime = sys::currentTime() - startTime;
+    }
+
+    modeKernel_t* device::loadKernelBuild(kernelBuild_t &build) {
+      const double startTime = sys::currentTime();
 
-      modeKernel_t *k = buildKernelFromBinary(binaryFilename,
-                                              kernelName,
-                                              kernelProps,
-                                              metadata.kernelsMetadata[kernelName]);
+      modeKernel_t *k;
+      if (build.foundBinary) {
+        if (build.kernelProps.get("verbose", false)) {
+          io::stdout << "Loading cached ["
+                     << build.kernelName
+                     << "] from ["
+                     << build.filename
+                     << "] in [" << build.binaryFilename << "]\n";
+        }
+        k = buildKernelFromBinary(build.binaryFilename,
+                                  build.kernelName,
+                                  build.kernelProps);
+      } else {
+        k = buildKernelFromBinary(build.binaryFilename,
+                                  build.kernelName,
+                                  build.kernelProps,
+                                  build.metadata.kernelsMetadata[build.kernelName]);
+      }
       if (k) {
-        k->sourceFilename = filename;
+        k->sourceFilename = build.filename;
+
+        occa::json &stats = k->buildStats;
+        stats["cache_hit"] = build.foundBinary;
+        stats["preprocess_time"] = build.metadata.preprocessTime;
+        stats["parse_time"] = build.metadata.parseTime;
+        stats["transform_time"] = build.metadata.transformTime;
+        stats["compile_time"] = build.compileTime;
+        stats["load_time"] = sys::currentTime() - startTime;
+        stats["binary_bytes"] = io::fileSize(build.binaryFilename);
       }
       return k;
     }
@@ -421,6 +1012,21 @@ namespace occa {
       k.dlHandle = sys::dlopen(filename);
       k.function = sys::dlsym(k.dlHandle, kernelName);
 
+      // OKL kernels come with a packed-argument entry point
+      functionPtr_t packedFunction = sys::dlsym(
+        k.dlHandle,
+        kernelName + lang::okl::serialParser::launchFunctionSuffix,
+        false
+      );
+      k.packedFunction = reinterpret_cast<packedFunctionPtr_t>(packedFunction);
+
+      functionPtr_t packedGraphFunction = sys::dlsym(
+        k.dlHandle,
+        kernelName + lang::okl::serialParser::graphLaunchFunctionSuffix,
+        false
+      );
+      k.packedGraphFunction = reinterpret_cast<packedFunctionPtr_t>(packedGraphFunction);
+
       return &k;
     }
     //==================================
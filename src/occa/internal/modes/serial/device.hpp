@@ -1,11 +1,43 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_DEVICE_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_DEVICE_HEADER
 
+#include <memory>
+
 #include <occa/defines.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/io/lock.hpp>
 
 namespace occa {
   namespace serial {
+    // State carried between the stages of a kernel build
+    class kernelBuild_t {
+    public:
+      std::string filename;
+      std::string kernelName;
+      hash_t kernelHash;
+      occa::json kernelProps;
+      bool isLauncherKernel;
+
+      std::string binaryFilename;
+      bool foundBinary;
+      // Held while this process translates and compiles the binary
+      std::shared_ptr<io::lock_t> lock;
+
+      std::string sourceFilename;
+      std::string compiler;
+      std::string compilerFlags;
+      std::string compilerLinkerFlags;
+      std::string compilerEnvScript;
+      lang::sourceMetadata_t metadata;
+      double compileTime;
+
+      kernelBuild_t(const std::string &filename_,
+                    const std::string &kernelName_,
+                    const hash_t &kernelHash_,
+                    const occa::json &kernelProps_,
+                    const bool isLauncherKernel_);
+    };
+
     class device : public occa::modeDevice_t {
       mutable hash_t hash_;
 
@@ -29,12 +61,24 @@ namespace occa {
                                  const streamTag &endTag);
       //================================
 
+      //---[ Graph ]--------------------
+      virtual modeGraph_t* createGraph();
+      //================================
+
       //---[ Kernel ]-------------------
       virtual bool parseFile(const std::string &filename,
                              const std::string &outputFile,
                              const occa::json &kernelProps,
                              lang::sourceMetadata_t &metadata);
 
+      // Translates [filename] with its literal defines left as macros, letting kernels
+      //   which only differ in those defines share one cached translation
+      bool parseFileWithSymbolicDefines(const std::string &filename,
+                                        const std::string &rawSourceFilename,
+                                        const std::string &outputFile,
+                                        const occa::json &kernelProps,
+                                        lang::sourceMetadata_t &metadata);
+
       virtual modeKernel_t* buildKernel(const std::string &filename,
                                         const std::string &kernelName,
                                         const hash_t kernelHash,
@@ -50,6 +94,22 @@ namespace occa {
                                 const occa::json &kernelProps,
                                 const bool isLauncerKernel);
 
+      virtual void buildKernels(std::vector<kernelBuildRequest_t> &requests,
+                                const int jobs);
+
+      // Translates the source and sets up the compiler command
+      bool prepareKernelBuild(kernelBuild_t &build);
+
+      // Only touches [build], allowing multiple compilations to run concurrently
+      void compileKernelBuild(kernelBuild_t &build);
+
+      modeKernel_t* loadKernelBuild(kernelBuild_t &build);
+
+      // Returns the kernel prelude header to force-include, with its precompiled header
+      //   cached per compiler and flags, or an empty string if it couldn't be built
+      std::string getPrecompiledPrelude(const kernelBuild_t &build,
+                                        const int compilerVendor);
+
       virtual modeKernel_t* buildKernelFromBinary(const std::string &filename,
                                                   const std::string &kernelName,
                                                   const occa::json &kernelProps);
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstring>
+
+#include <occa/internal/core/memory.hpp>
+#include <occa/internal/modes/serial/graph.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
+
+namespace occa {
+  namespace serial {
+    graphLaunch_t::graphLaunch_t() :
+      function(NULL),
+      packedFunction(NULL),
+      packedGraphFunction(NULL),
+      argc(0),
+      dest(NULL),
+      src(NULL),
+      bytes(0) {}
+
+    bool graphLaunch_t::isKernel() const {
+      return (function || packedFunction);
+    }
+
+    void graphLaunch_t::run() {
+      if (!isKernel()) {
+        ::memcpy(dest, src, bytes);
+      } else if (packedFunction) {
+        packedFunction(&(args[0]));
+      } else {
+        sys::runFunction(function, argc, &(args[0]));
+      }
+    }
+
+    graphRegion_t::graphRegion_t(const int start_,
+                                 const int end_,
+                                 const bool isParallel_) :
+      start(start_),
+      end(end_),
+      isParallel(isParallel_) {}
+
+    graph::graph(modeDevice_t *modeDevice_) :
+      occa::modeGraph_t(modeDevice_) {}
+
+    void graph::finalize() {
+      modeGraph_t::finalize();
+
+      const int nodeCount = (int) nodes.size();
+      launches.resize(nodeCount);
+      for (int i = 0; i < nodeCount; ++i) {
+        graphNode_t &node = nodes[i];
+        graphLaunch_t &launch = launches[i];
+
+        if (node.type == graphNodeType::kernel) {
+          kernel *k = dynamic_cast<kernel*>(node.kernel.getModeKernel());
+          OCCA_ERROR("Graph kernel has been freed",
+                     k != NULL);
+
+          launch.function = k->function;
+          launch.packedFunction = k->packedFunction;
+          launch.packedGraphFunction = k->packedGraphFunction;
+
+          // Pointers to the values stored in the node arguments
+          launch.argc = (int) node.arguments.size();
+          launch.args.resize(std::max(launch.argc, 1));
+          for (int arg = 0; arg < launch.argc; ++arg) {
+            launch.args[arg] = node.arguments[arg].ptr();
+          }
+          continue;
+        }
+
+        modeMemory_t *dest = node.dest.getModeMemory();
+        modeMemory_t *src = node.src.getModeMemory();
+        OCCA_ERROR("Graph copy memory has been freed",
+                   (dest || node.hostDest) && (src || node.hostSrc));
+
+        launch.dest = node.hostDest ? node.hostDest : (dest->ptr + node.destOffset);
+        launch.src = node.hostSrc ? node.hostSrc : (src->ptr + node.srcOffset);
+        launch.bytes = node.bytes;
+      }
+
+      // Split the nodes into parallel regions of shareable launches, with other
+      //   launches running on their own
+      int start = 0;
+      while (start < nodeCount) {
+        int end = start;
+        bool hasGraphKernel = false;
+        while ((end < nodeCount) && canShareRegion(launches[end])) {
+          hasGraphKernel |= launches[end].isKernel();
+          ++end;
+        }
+
+        if (hasGraphKernel) {
+          regions.push_back(graphRegion_t(start, end, true));
+        } else {
+          end = std::max(end, start + 1);
+          regions.push_back(graphRegion_t(start, end, false));
+        }
+        start = end;
+      }
+    }
+
+    bool graph::canShareRegion(const graphLaunch_t &launch) const {
+#if OCCA_OPENMP_ENABLED
+      return (!launch.isKernel() || launch.packedGraphFunction);
+#else
+      return false;
+#endif
+    }
+
+    void graph::launch() {
+      stream *s = getStream(modeDevice);
+      if (s && s->isAsync()) {
+        s->enqueue([this]() {
+          run();
+        });
+        return;
+      }
+
+      run();
+    }
+
+    void graph::run() {
+      for (const graphRegion_t &region : regions) {
+        if (region.isParallel) {
+          runParallelRegion(region);
+          continue;
+        }
+        for (int i = region.start; i < region.end; ++i) {
+          launches[i].run();
+        }
+      }
+    }
+
+    void graph::runParallelRegion(const graphRegion_t &region) {
+#if OCCA_OPENMP_ENABLED
+      // Each kernel ends with the implicit barrier of its [omp for] loops and
+      //   copies end with the implicit barrier of [omp single]
+#pragma omp parallel
+      {
+        for (int i = region.start; i < region.end; ++i) {
+          graphLaunch_t &launch = launches[i];
+          if (launch.isKernel()) {
+            launch.packedGraphFunction(&(launch.args[0]));
+          } else {
+#pragma omp single
+            ::memcpy(launch.dest, launch.src, launch.bytes);
+          }
+        }
+      }
+#endif
+    }
+  }
+}
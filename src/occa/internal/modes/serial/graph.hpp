@@ -0,0 +1,68 @@
+#ifndef OCCA_INTERNAL_MODES_SERIAL_GRAPH_HEADER
+#define OCCA_INTERNAL_MODES_SERIAL_GRAPH_HEADER
+
+#include <vector>
+
+#include <occa/internal/core/graph.hpp>
+#include <occa/internal/modes/serial/kernel.hpp>
+
+namespace occa {
+  namespace serial {
+    // Node with the function and argument pointers resolved when the capture ends
+    class graphLaunch_t {
+    public:
+      // Kernel launches
+      functionPtr_t function;
+      packedFunctionPtr_t packedFunction;
+      packedFunctionPtr_t packedGraphFunction;
+      int argc;
+      std::vector<void*> args;
+
+      // Copies
+      void *dest;
+      const void *src;
+      udim_t bytes;
+
+      graphLaunch_t();
+
+      bool isKernel() const;
+
+      void run();
+    };
+
+    // Nodes [start, end) replayed together
+    class graphRegion_t {
+    public:
+      int start;
+      int end;
+      bool isParallel;
+
+      graphRegion_t(const int start_,
+                    const int end_,
+                    const bool isParallel_);
+    };
+
+    // Consecutive OpenMP kernels and the copies between them are replayed inside a
+    //   single parallel region, where their @outer loops are shared by the threads
+    class graph : public occa::modeGraph_t {
+    private:
+      std::vector<graphLaunch_t> launches;
+      std::vector<graphRegion_t> regions;
+
+    public:
+      graph(modeDevice_t *modeDevice_);
+
+      void finalize() override;
+      void launch() override;
+
+    private:
+      // Whether the launch can run inside a parallel region shared with other launches
+      bool canShareRegion(const graphLaunch_t &launch) const;
+
+      void run();
+      void runParallelRegion(const graphRegion_t &region);
+    };
+  }
+}
+
+#endif
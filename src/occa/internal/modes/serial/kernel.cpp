@@ -1,7 +1,9 @@
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/internal/core/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 
 namespace occa {
@@ -13,15 +15,43 @@ namespace occa {
       occa::modeKernel_t(modeDevice_, name_, sourceFilename_, properties_),
       dlHandle(NULL),
       function(NULL),
+      packedFunction(NULL),
+      packedGraphFunction(NULL),
       isLauncherKernel(false) {}
 
     kernel::~kernel() {
       if (dlHandle) {
+        // Queued launches may still reference the kernel function
+        if (modeDevice) {
+          modeDevice->finishAll();
+        }
         sys::dlclose(dlHandle);
         dlHandle = NULL;
       }
     }
 
+    modeKernel_t* kernel::clone() const {
+      if (!dlHandle) {
+        return NULL;
+      }
+
+      kernel &k = *(new kernel(modeDevice, name, sourceFilename, properties));
+      k.binaryFilename = binaryFilename;
+      k.hash = hash;
+      k.outerDims = outerDims;
+      k.innerDims = innerDims;
+      k.metadata = metadata;
+
+      // dlopen is reference counted, so the binary stays loaded until every clone is freed
+      k.dlHandle = sys::dlopen(binaryFilename);
+      k.function = function;
+      k.packedFunction = packedFunction;
+      k.packedGraphFunction = packedGraphFunction;
+      k.isLauncherKernel = isLauncherKernel;
+
+      return &k;
+    }
+
     int kernel::maxDims() const {
       return 3;
     }
@@ -39,19 +69,43 @@ namespace occa {
     }
 
     void kernel::run() const {
-      const int args = (int) arguments.size();
+      stream *s = getStream(modeDevice);
+      if (s && s->isAsync()) {
+        // Copy the arguments since primitive values are stored inside them
+        const functionPtr_t launchFunction = function;
+        const packedFunctionPtr_t launchPackedFunction = packedFunction;
+        const std::vector<kernelArgData> launchArguments = arguments;
+        s->enqueue([launchFunction, launchPackedFunction, launchArguments]() {
+          std::vector<void*> launchArgs;
+          launch(launchFunction, launchPackedFunction, launchArguments, launchArgs);
+        });
+        return;
+      }
+
+      launch(function, packedFunction, arguments, vArgs);
+    }
+
+    void kernel::launch(functionPtr_t launchFunction,
+                        packedFunctionPtr_t launchPackedFunction,
+                        const std::vector<kernelArgData> &launchArguments,
+                        std::vector<void*> &launchArgs) {
+      const int args = (int) launchArguments.size();
       if (!args) {
-        vArgs.resize(1);
-      } else if ((int) vArgs.size() < args) {
-        vArgs.resize(args);
+        launchArgs.resize(1);
+      } else if ((int) launchArgs.size() < args) {
+        launchArgs.resize(args);
       }
 
       // Set arguments
       for (int i = 0; i < args; ++i) {
-        vArgs[i] = arguments[i].ptr();
+        launchArgs[i] = launchArguments[i].ptr();
       }
 
-      sys::runFunction(function, args, &(vArgs[0]));
+      if (launchPackedFunction) {
+        launchPackedFunction(&(launchArgs[0]));
+      } else {
+        sys::runFunction(launchFunction, args, &(launchArgs[0]));
+      }
     }
   }
 }
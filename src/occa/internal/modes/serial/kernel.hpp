@@ -10,11 +10,19 @@
 namespace occa {
   namespace serial {
     class device;
+    class graph;
+
+    // Generated entry point which unpacks an array of argument pointers
+    typedef void (*packedFunctionPtr_t)(void **args);
 
     class kernel : public occa::modeKernel_t {
     protected:
       void *dlHandle;
       functionPtr_t function;
+      packedFunctionPtr_t packedFunction;
+      // OpenMP entry point whose @outer loops are shared by the threads of the
+      //   enclosing parallel region, used to replay graphs
+      packedFunctionPtr_t packedGraphFunction;
       mutable std::vector<void*> vArgs;
 
     public:
@@ -34,7 +42,15 @@ namespace occa {
 
       void run() const;
 
+      modeKernel_t* clone() const;
+
+      static void launch(functionPtr_t launchFunction,
+                         packedFunctionPtr_t launchPackedFunction,
+                         const std::vector<kernelArgData> &launchArguments,
+                         std::vector<void*> &launchArgs);
+
       friend class device;
+      friend class graph;
     };
   }
 }
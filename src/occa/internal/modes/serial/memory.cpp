@@ -1,6 +1,7 @@
 #include <cstring>
 #include <occa/internal/modes/serial/buffer.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/core/device.hpp>
 
@@ -25,7 +26,7 @@ namespace occa {
                         const occa::json &props) const {
       const void *srcPtr = ptr + offset_;
 
-      ::memcpy(dest, srcPtr, bytes);
+      enqueueCopy(dest, srcPtr, bytes, props);
     }
 
     void memory::copyFrom(const void *src,
@@ -36,7 +37,7 @@ namespace occa {
       void *destPtr      = ptr + offset_;
       const void *srcPtr = src;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      enqueueCopy(destPtr, srcPtr, bytes, props);
     }
 
     void memory::copyFrom(const modeMemory_t *src,
@@ -48,7 +49,29 @@ namespace occa {
       void *destPtr      = ptr + destOffset;
       const void *srcPtr = src->ptr + srcOffset;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      enqueueCopy(destPtr, srcPtr, bytes, props);
+    }
+
+    void memory::enqueueCopy(void *dest,
+                             const void *src,
+                             const udim_t bytes,
+                             const occa::json &props) const {
+      stream *s = getStream(getModeDevice());
+      if (!s || !s->isAsync()) {
+        ::memcpy(dest, src, bytes);
+        return;
+      }
+
+      if (props.get("async", false)) {
+        s->enqueue([dest, src, bytes]() {
+          ::memcpy(dest, src, bytes);
+        });
+        return;
+      }
+
+      // Blocking copies need to see the results of queued work
+      s->finish();
+      ::memcpy(dest, src, bytes);
     }
   }
 }
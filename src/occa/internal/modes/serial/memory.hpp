@@ -29,6 +29,12 @@ namespace occa {
                     const udim_t destOffset,
                     const udim_t srcOffset,
                     const occa::json &props);
+
+    private:
+      void enqueueCopy(void *dest,
+                       const void *src,
+                       const udim_t bytes,
+                       const occa::json &props) const;
     };
   }
 }
@@ -6,9 +6,25 @@ namespace occa {
   namespace serial {
     streamTag::streamTag(modeDevice_t *modeDevice_,
                          double time_) :
+      modeStreamTag_t(modeDevice_) {
+      std::promise<double> promise;
+      promise.set_value(time_);
+      time = promise.get_future().share();
+    }
+
+    streamTag::streamTag(modeDevice_t *modeDevice_,
+                         std::shared_future<double> time_) :
       modeStreamTag_t(modeDevice_),
       time(time_) {}
 
     streamTag::~streamTag() {}
+
+    void streamTag::wait() const {
+      time.wait();
+    }
+
+    double streamTag::getTime() const {
+      return time.get();
+    }
   }
 }
@@ -1,12 +1,81 @@
+#include <occa/internal/core/device.hpp>
 #include <occa/internal/modes/serial/stream.hpp>
 
 namespace occa {
   namespace serial {
     stream::stream(modeDevice_t *modeDevice_,
                    const occa::json &properties_) :
-      modeStream_t(modeDevice_, properties_) {}
+      modeStream_t(modeDevice_, properties_),
+      async(properties_.get("async", false)),
+      stopWorker(false),
+      pendingTasks(0) {}
 
-    stream::~stream() {}
-    void stream::finish() {}
+    stream::~stream() {
+      if (!worker.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        stopWorker = true;
+      }
+      taskAdded.notify_one();
+      worker.join();
+    }
+
+    bool stream::isAsync() const {
+      return async;
+    }
+
+    void stream::enqueue(streamTask_t task) {
+      if (!async) {
+        task();
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        // Lazily start the worker so unused streams don't hold a thread
+        if (!worker.joinable()) {
+          worker = std::thread(&stream::runWorker, this);
+        }
+        tasks.push_back(std::move(task));
+        ++pendingTasks;
+      }
+      taskAdded.notify_one();
+    }
+
+    void stream::finish() {
+      if (!async) {
+        return;
+      }
+      std::unique_lock<std::mutex> lock(taskMutex);
+      tasksFinished.wait(lock, [&] { return pendingTasks == 0; });
+    }
+
+    void stream::runWorker() {
+      std::unique_lock<std::mutex> lock(taskMutex);
+      while (true) {
+        taskAdded.wait(lock, [&] { return stopWorker || !tasks.empty(); });
+
+        // Drain the queue before stopping
+        if (tasks.empty()) {
+          return;
+        }
+
+        streamTask_t task = std::move(tasks.front());
+        tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        if (--pendingTasks == 0) {
+          tasksFinished.notify_all();
+        }
+      }
+    }
+
+    stream* getStream(modeDevice_t *modeDevice) {
+      return dynamic_cast<stream*>(modeDevice->currentStream.getModeStream());
+    }
   }
 }
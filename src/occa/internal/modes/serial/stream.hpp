@@ -1,19 +1,50 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_STREAM_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_STREAM_HEADER
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include <occa/defines.hpp>
 #include <occa/internal/core/stream.hpp>
 
 namespace occa {
   namespace serial {
+    typedef std::function<void()> streamTask_t;
+
+    // Streams created with {"async": true} own a worker thread which
+    // runs queued launches and copies in order.
+    // Without it, work runs synchronously on the caller thread.
     class stream : public occa::modeStream_t {
+    private:
+      bool async;
+      bool stopWorker;
+      int pendingTasks;
+
+      std::thread worker;
+      std::mutex taskMutex;
+      std::condition_variable taskAdded;
+      std::condition_variable tasksFinished;
+      std::deque<streamTask_t> tasks;
+
     public:
       stream(modeDevice_t *modeDevice_,
              const occa::json &properties_);
 
       virtual ~stream();
+
+      bool isAsync() const;
+
+      void enqueue(streamTask_t task);
       void finish() override;
+
+    private:
+      void runWorker();
     };
+
+    stream* getStream(modeDevice_t *modeDevice);
   }
 }
 
@@ -3,18 +3,28 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_STREAMTAG_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_STREAMTAG_HEADER
 
+#include <future>
+
 #include <occa/internal/core/streamTag.hpp>
 
 namespace occa {
   namespace serial {
     class streamTag : public occa::modeStreamTag_t {
     public:
-      double time;
+      // Tags on async streams are resolved by the stream worker
+      //   once all previously queued work has completed
+      std::shared_future<double> time;
 
       streamTag(modeDevice_t *modeDevice_,
                 double time_);
 
+      streamTag(modeDevice_t *modeDevice_,
+                std::shared_future<double> time_);
+
       virtual ~streamTag();
+
+      void wait() const;
+      double getTime() const;
     };
   }
 }
@@ -0,0 +1,478 @@
+#include <occa/defines.hpp>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <errno.h>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/time.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/compileServer.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/utils/logging.hpp>
+
+namespace occa {
+  namespace compileServer {
+    const std::string outputPlaceholder = "${OCCA_COMPILE_OUTPUT}";
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    namespace {
+      class compileJob_t {
+      public:
+        std::string binaryFilename;
+        std::string command;
+        bool done;
+        int exitCode;
+        std::string output;
+
+        compileJob_t(const std::string &binaryFilename_,
+                     const std::string &command_) :
+          binaryFilename(binaryFilename_),
+          command(command_),
+          done(false),
+          exitCode(0) {}
+      };
+
+      typedef std::shared_ptr<compileJob_t> compileJobPtr;
+
+      class server_t {
+      public:
+        std::mutex mutex;
+        std::condition_variable condition;
+        // Set by a stop request to end the accept loop
+        bool stopRequested;
+        // Set once no more jobs are accepted, letting workers exit after the queue drains
+        bool stopping;
+
+        // Pending and running jobs keyed by their binary
+        std::map<std::string, compileJobPtr> jobs;
+        std::deque<compileJobPtr> queue;
+
+        // Threads handling a client request
+        int activeClients;
+
+        int compiled;
+        int deduplicated;
+
+        server_t() :
+          stopRequested(false),
+          stopping(false),
+          activeClients(0),
+          compiled(0),
+          deduplicated(0) {}
+      };
+
+      bool writeAll(const int fd, const std::string &str) {
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        // Clients that give up shouldn't kill the server with SIGPIPE
+        flags = MSG_NOSIGNAL;
+#endif
+        const char *c = str.c_str();
+        size_t bytesLeft = str.size();
+        while (bytesLeft) {
+          const ssize_t bytes = ::send(fd, c, bytesLeft, flags);
+          if (bytes < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+            return false;
+          }
+          c += bytes;
+          bytesLeft -= bytes;
+        }
+        return true;
+      }
+
+      std::string readAll(const int fd) {
+        std::string str;
+        char buffer[4096];
+        while (true) {
+          const ssize_t bytes = ::read(fd, buffer, sizeof(buffer));
+          if (bytes < 0 && errno == EINTR) {
+            continue;
+          }
+          if (bytes <= 0) {
+            break;
+          }
+          str.append(buffer, bytes);
+        }
+        return str;
+      }
+
+      bool getSocketAddress(const std::string &socketPath,
+                            sockaddr_un &address) {
+        ::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (!socketPath.size() || (socketPath.size() >= sizeof(address.sun_path))) {
+          return false;
+        }
+        ::strcpy(address.sun_path, socketPath.c_str());
+        return true;
+      }
+
+      // Each request is a single JSON message, the end of a message is marked by
+      //   shutting down the writing side of the socket
+      bool sendRequest(const std::string &socketPath,
+                       const occa::json &request,
+                       occa::json &response) {
+        sockaddr_un address;
+        if (!getSocketAddress(io::expandFilename(socketPath), address)) {
+          return false;
+        }
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+          return false;
+        }
+        if (::connect(fd, (sockaddr*) &address, sizeof(address)) ||
+            !writeAll(fd, request.dump(0))) {
+          ::close(fd);
+          return false;
+        }
+        ::shutdown(fd, SHUT_WR);
+
+        const std::string responseStr = readAll(fd);
+        ::close(fd);
+        if (!responseStr.size()) {
+          return false;
+        }
+
+        response = occa::json::parse(responseStr);
+        return true;
+      }
+
+      void runJobs(server_t &server) {
+        while (true) {
+          compileJobPtr job;
+          {
+            std::unique_lock<std::mutex> lock(server.mutex);
+            server.condition.wait(lock, [&]() {
+              return server.queue.size() || server.stopping;
+            });
+            // Drain the queue before stopping so no client is left waiting
+            if (!server.queue.size()) {
+              return;
+            }
+            job = server.queue.front();
+            server.queue.pop_front();
+          }
+
+          int exitCode = 0;
+          std::string output;
+          // Errors are reported to the clients waiting on the job instead of stopping the server
+          try {
+            io::stageFile(
+              job->binaryFilename,
+              true,
+              [&](const std::string &tempFilename) -> bool {
+                std::string command = job->command;
+                size_t pos;
+                while ((pos = command.find(outputPlaceholder)) != std::string::npos) {
+                  command.replace(pos, outputPlaceholder.size(), tempFilename);
+                }
+                exitCode = sys::call(command.c_str(), output);
+                return !exitCode;
+              }
+            );
+          } catch (std::exception &e) {
+            exitCode = 1;
+            output += e.what();
+          }
+
+          std::unique_lock<std::mutex> lock(server.mutex);
+          job->exitCode = exitCode;
+          job->output = output;
+          job->done = true;
+          server.jobs.erase(job->binaryFilename);
+          ++server.compiled;
+          server.condition.notify_all();
+        }
+      }
+
+      // Only processes of the user running the server can send it commands
+      bool isServerUser(const int fd) {
+#if (OCCA_OS & OCCA_LINUX_OS)
+        ucred credentials;
+        socklen_t size = sizeof(credentials);
+        if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size)) {
+          return false;
+        }
+        return credentials.uid == ::geteuid();
+#else
+        uid_t uid;
+        gid_t gid;
+        if (::getpeereid(fd, &uid, &gid)) {
+          return false;
+        }
+        return uid == ::geteuid();
+#endif
+      }
+
+      // Binaries are only written to the server's cache directory
+      bool isCacheFilename(const std::string &filename) {
+        return (
+          startsWith(filename, io::expandFilename(io::cachePath()))
+          && (filename.find("/../") == std::string::npos)
+        );
+      }
+
+      void respondToCompile(server_t &server,
+                            const occa::json &request,
+                            occa::json &response) {
+        const std::string binaryFilename = request["binary"];
+        if (!isCacheFilename(binaryFilename)) {
+          response["error"] = "Binary [" + binaryFilename + "] is outside of the cache directory";
+          return;
+        }
+
+        compileJobPtr job;
+        std::unique_lock<std::mutex> lock(server.mutex);
+        if (server.stopping) {
+          response["error"] = "Compile server is stopping";
+          return;
+        }
+
+        auto it = server.jobs.find(binaryFilename);
+        if (it != server.jobs.end()) {
+          job = it->second;
+          ++server.deduplicated;
+        } else {
+          job = std::make_shared<compileJob_t>(binaryFilename,
+                                               (std::string) request["command"]);
+          server.jobs[binaryFilename] = job;
+          server.queue.push_back(job);
+          server.condition.notify_all();
+        }
+        server.condition.wait(lock, [&]() {
+          return job->done;
+        });
+
+        response["exit_code"] = job->exitCode;
+        response["output"] = job->output;
+      }
+
+      // Requests are read on the client's thread so slow clients don't block others
+      void handleClient(server_t &server,
+                        const int fd) {
+        // Drop clients that never finish sending their request
+        timeval timeout;
+        timeout.tv_sec = 30;
+        timeout.tv_usec = 0;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        occa::json response;
+        bool isStopRequest = false;
+        try {
+          const std::string requestStr = readAll(fd);
+          const occa::json request = occa::json::parse(requestStr);
+          const std::string requestType = request.get<std::string>("type");
+
+          response["type"] = requestType;
+          if (requestType == "compile") {
+            respondToCompile(server, request, response);
+          } else if (requestType == "stats") {
+            std::unique_lock<std::mutex> lock(server.mutex);
+            response["compiled"] = server.compiled;
+            response["deduplicated"] = server.deduplicated;
+            response["pending"] = (int) server.jobs.size();
+          } else if (requestType == "stop") {
+            isStopRequest = true;
+          } else {
+            response["error"] = "Unknown request type [" + requestType + "]";
+          }
+        } catch (std::exception &e) {
+          response = occa::json();
+          response["error"] = std::string("Invalid request: ") + e.what();
+        }
+
+        writeAll(fd, response.dump(0));
+        ::close(fd);
+
+        std::unique_lock<std::mutex> lock(server.mutex);
+        if (isStopRequest) {
+          server.stopRequested = true;
+        }
+        --server.activeClients;
+        server.condition.notify_all();
+      }
+    }
+#endif
+
+    std::string getSocketPath(const occa::json &kernelProps) {
+      if (env::var("OCCA_COMPILE_SERVER").size()) {
+        return env::var("OCCA_COMPILE_SERVER");
+      }
+      return kernelProps.get<std::string>("compile_server");
+    }
+
+    bool compile(const std::string &socketPath,
+                 const std::string &binaryFilename,
+                 const std::string &command,
+                 int &exitCode,
+                 std::string &output) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      occa::json request;
+      request["type"] = "compile";
+      request["binary"] = io::expandFilename(binaryFilename);
+      request["command"] = command;
+
+      // Compile locally if the server rejects the request
+      occa::json response;
+      if (!sendRequest(socketPath, request, response) ||
+          response.has("error")) {
+        return false;
+      }
+      exitCode = response["exit_code"];
+      output = (std::string) response["output"];
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    bool getStats(const std::string &socketPath,
+                  occa::json &stats) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      occa::json request;
+      request["type"] = "stats";
+      return sendRequest(socketPath, request, stats);
+#else
+      return false;
+#endif
+    }
+
+    bool stop(const std::string &socketPath) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      occa::json request, response;
+      request["type"] = "stop";
+      return sendRequest(socketPath, request, response);
+#else
+      return false;
+#endif
+    }
+
+    bool serve(const std::string &socketPath,
+               const int jobs) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const std::string expSocketPath = io::expandFilename(socketPath);
+
+      sockaddr_un address;
+      if (!getSocketAddress(expSocketPath, address)) {
+        printError("Compile server socket path [" + expSocketPath + "] is too long");
+        return false;
+      }
+
+      // Remove sockets left behind by servers that didn't shut down cleanly
+      sys::mkpath(io::dirname(expSocketPath));
+      ::unlink(expSocketPath.c_str());
+
+      // Other users can't connect since the server runs their commands as its user
+      const int serverFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      const mode_t previousUmask = ::umask(0077);
+      const bool isListening = (
+        (serverFd >= 0)
+        && !::bind(serverFd, (sockaddr*) &address, sizeof(address))
+        && !::chmod(expSocketPath.c_str(), 0600)
+        && !::listen(serverFd, SOMAXCONN)
+      );
+      ::umask(previousUmask);
+      if (!isListening) {
+        printError("Unable to listen on compile server socket [" + expSocketPath + "]");
+        if (serverFd >= 0) {
+          ::close(serverFd);
+        }
+        return false;
+      }
+
+      server_t server;
+
+      std::vector<std::thread> workers;
+      for (int i = 0; i < std::max(jobs, 1); ++i) {
+        workers.push_back(std::thread(runJobs, std::ref(server)));
+      }
+
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(server.mutex);
+          if (server.stopRequested) {
+            break;
+          }
+        }
+
+        // Wake up periodically to check for stop requests
+        pollfd serverPoll;
+        serverPoll.fd = serverFd;
+        serverPoll.events = POLLIN;
+        serverPoll.revents = 0;
+        const int readyCount = ::poll(&serverPoll, 1, 100);
+        if (readyCount < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          break;
+        }
+        if (!readyCount) {
+          continue;
+        }
+
+        const int fd = ::accept(serverFd, NULL, NULL);
+        if (fd < 0) {
+          if ((errno == EINTR) || (errno == ECONNABORTED)) {
+            continue;
+          }
+          break;
+        }
+        if (!isServerUser(fd)) {
+          ::close(fd);
+          continue;
+        }
+
+        {
+          std::unique_lock<std::mutex> lock(server.mutex);
+          ++server.activeClients;
+        }
+        std::thread(handleClient, std::ref(server), fd).detach();
+      }
+
+      {
+        std::unique_lock<std::mutex> lock(server.mutex);
+        server.stopping = true;
+        server.condition.notify_all();
+      }
+      for (std::thread &worker : workers) {
+        worker.join();
+      }
+      {
+        std::unique_lock<std::mutex> lock(server.mutex);
+        server.condition.wait(lock, [&]() {
+          return server.activeClients == 0;
+        });
+      }
+
+      ::close(serverFd);
+      ::unlink(expSocketPath.c_str());
+      return true;
+#else
+      printError("The compile server is only supported on Linux and macOS");
+      return false;
+#endif
+    }
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef OCCA_INTERNAL_UTILS_COMPILESERVER_HEADER
+#define OCCA_INTERNAL_UTILS_COMPILESERVER_HEADER
+
+#include <string>
+
+#include <occa/types/json.hpp>
+
+namespace occa {
+  // Node-local daemon started with [occa compile-server] which runs host kernel compilations
+  //   for every process on the node, compiling each cached binary only once
+  namespace compileServer {
+    // Replaced by the server with the staged output filename
+    extern const std::string outputPlaceholder;
+
+    // Socket from OCCA_COMPILE_SERVER or the [compile_server] kernel property
+    std::string getSocketPath(const occa::json &kernelProps);
+
+    // Returns false if the server couldn't be reached
+    bool compile(const std::string &socketPath,
+                 const std::string &binaryFilename,
+                 const std::string &command,
+                 int &exitCode,
+                 std::string &output);
+
+    bool getStats(const std::string &socketPath,
+                  occa::json &stats);
+
+    bool stop(const std::string &socketPath);
+
+    // Blocks until a stop request is received
+    bool serve(const std::string &socketPath,
+               const int jobs);
+  }
+}
+
+#endif
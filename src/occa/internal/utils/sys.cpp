@@ -32,8 +32,12 @@
 #  include <windows.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 #include <sys/types.h>
 #include <fcntl.h>
@@ -429,6 +433,59 @@ namespace occa {
     }
     //==================================
 
+    //---[ Threading ]------------------
+    int defaultJobCount() {
+      const int jobs = env::get<int>("OCCA_BUILD_JOBS", 0);
+      if (jobs > 0) {
+        return jobs;
+      }
+      return std::max(1, (int) std::thread::hardware_concurrency());
+    }
+
+    void parallelFor(const int taskCount,
+                     const int maxJobs,
+                     std::function<void(const int taskIndex)> func) {
+      const int jobs = std::min(taskCount, maxJobs);
+      if (jobs <= 1) {
+        for (int i = 0; i < taskCount; ++i) {
+          func(i);
+        }
+        return;
+      }
+
+      std::atomic<int> nextTask(0);
+      std::vector<std::exception_ptr> errors(taskCount);
+
+      auto runTasks = [&]() {
+        int taskIndex;
+        while ((taskIndex = nextTask++) < taskCount) {
+          try {
+            func(taskIndex);
+          } catch (...) {
+            errors[taskIndex] = std::current_exception();
+          }
+        }
+      };
+
+      // The calling thread also picks up tasks
+      std::vector<std::thread> threads;
+      for (int i = 1; i < jobs; ++i) {
+        threads.push_back(std::thread(runTasks));
+      }
+      runTasks();
+
+      for (std::thread &thread : threads) {
+        thread.join();
+      }
+
+      for (std::exception_ptr &error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+    //==================================
+
     //---[ Processor Info ]-------------
     json SystemInfo::getSystemInfo() {
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
@@ -945,13 +1002,19 @@ namespace occa {
     }
 
     functionPtr_t dlsym(void *dlHandle,
-                        const std::string &functionName) {
+                        const std::string &functionName,
+                        const bool required) {
       OCCA_ERROR("dl handle is NULL",
                  dlHandle);
 
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      // Clear previous errors
+      dlerror();
       void *sym = ::dlsym(dlHandle, functionName.c_str());
 
+      if (!sym && !required) {
+        return NULL;
+      }
       if (!sym) {
         char *error = dlerror();
         if (error) {
@@ -963,6 +1026,9 @@ namespace occa {
 #else
       void *sym = GetProcAddress((HMODULE) dlHandle, functionName.c_str());
 
+      if (sym == NULL && !required) {
+        return NULL;
+      }
       if (sym == NULL) {
         OCCA_FORCE_ERROR("Error loading symbol [" << functionName << "] from binary with GetProcAddress");
       }
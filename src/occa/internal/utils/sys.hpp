@@ -1,6 +1,7 @@
 #ifndef OCCA_INTERNAL_UTILS_SYS_HEADER
 #define OCCA_INTERNAL_UTILS_SYS_HEADER
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 
@@ -69,6 +70,16 @@ namespace occa {
     void pinToCore(const int core);
     //==================================
 
+    //---[ Threading ]------------------
+    int defaultJobCount();
+
+    // Runs func(0), ..., func(taskCount - 1) on up to maxJobs threads
+    // The first exception thrown (by task index) is rethrown once all tasks finish
+    void parallelFor(const int taskCount,
+                     const int maxJobs,
+                     std::function<void(const int taskIndex)> func);
+    //==================================
+
     //---[ Processor Info ]-------------
     class CacheInfo {
      public:
@@ -155,8 +166,10 @@ namespace occa {
 
     void* dlopen(const std::string &filename);
 
+    // Returns NULL for missing symbols if [required] is false
     functionPtr_t dlsym(void *dlHandle,
-                        const std::string &functionName);
+                        const std::string &functionName,
+                        const bool required = true);
 
     void dlclose(void *dlHandle);
 
@@ -1,12 +1,32 @@
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
 #include <occa.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/sys.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 void testProperties();
 void testWrapMemory();
+void testAsyncStream();
+void testKernelCache();
+void testBuildKernels();
+void testMemoryPool();
+void testSymbolicDefines();
+void testPrecompiledPrelude();
+void testBuildStats();
 
 int main(const int argc, const char **argv) {
   testProperties();
   testWrapMemory();
+  testAsyncStream();
+  testKernelCache();
+  testBuildKernels();
+  testMemoryPool();
+  testSymbolicDefines();
+  testPrecompiledPrelude();
+  testBuildStats();
 
   return 0;
 }
@@ -122,3 +142,452 @@ void testWrapMemory() {
   ASSERT_EQ(mem.ptr<int>(), hostPtr);
   ASSERT_EQ((int) mem.length<int>(), 1);
 }
+
+void testAsyncStream() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  occa::stream asyncStream = device.createStream({
+    {"async", true}
+  });
+  device.setStream(asyncStream);
+
+  occa::kernel fill = device.buildKernelFromString(
+    "@kernel void fill(const int N, const int value, int *array) {"
+    "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {"
+    "    array[i] = value;"
+    "  }"
+    "}",
+    "fill"
+  );
+
+  const int N = 1024;
+  int *values = new int[N];
+  for (int i = 0; i < N; ++i) {
+    values[i] = 0;
+  }
+
+  occa::memory mem = device.malloc<int>(N);
+
+  occa::streamTag startTag = device.tagStream();
+  fill(N, 1, mem);
+  fill(N, 2, mem);
+  mem.copyTo(values, occa::json({{"async", true}}));
+  occa::streamTag endTag = device.tagStream();
+
+  device.finish();
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(values[i], 2);
+  }
+  ASSERT_TRUE(device.timeBetween(startTag, endTag) >= 0);
+
+  // Blocking copies wait for queued work
+  fill(N, 3, mem);
+  mem.copyTo(values);
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(values[i], 3);
+  }
+
+  delete [] values;
+}
+
+void testKernelCache() {
+  occa::device device({
+    {"mode", "Serial"},
+    {"kernel_cache_size", 1}
+  });
+
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+
+  occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors");
+  occa::kernel addVectors2 = device.buildKernel(addVectorsFile, "addVectors");
+
+  // Cache hits return separate kernels sharing the same binary
+  ASSERT_TRUE(addVectors != addVectors2);
+  ASSERT_EQ(addVectors.binaryFilename(), addVectors2.binaryFilename());
+
+  occa::json stats = device.kernelCacheStats();
+  ASSERT_EQ((int) stats["hits"], 1);
+  ASSERT_EQ((int) stats["misses"], 1);
+  ASSERT_EQ((int) stats["size"], 1);
+
+  // Different props are cached separately and evict the least recently used kernel
+  occa::kernel addVectors3 = device.buildKernel(addVectorsFile, "addVectors", {
+    {"defines/FOO", 1}
+  });
+  ASSERT_TRUE(addVectors != addVectors3);
+  ASSERT_EQ((int) device.kernelCacheStats()["size"], 1);
+
+  // Evicted kernels stay alive while referenced
+  ASSERT_TRUE(addVectors.isInitialized());
+  ASSERT_TRUE(addVectors != device.buildKernel(addVectorsFile, "addVectors"));
+
+  const int entries = 5;
+  float ab[entries];
+  for (int i = 0; i < entries; ++i) {
+    ab[i] = i;
+  }
+  occa::memory o_a = device.malloc<float>(entries, ab);
+  occa::memory o_b = device.malloc<float>(entries, ab);
+  occa::memory o_ab = device.malloc<float>(entries);
+  occa::memory o_ab2 = device.malloc<float>(entries);
+
+  // Arguments aren't shared between cached kernels
+  occa::kernel addVectors4 = device.buildKernel(addVectorsFile, "addVectors");
+  occa::kernel addVectors5 = device.buildKernel(addVectorsFile, "addVectors");
+  addVectors4.pushArg(entries);
+  addVectors4.pushArg(o_a);
+  addVectors4.pushArg(o_b);
+  addVectors4.pushArg(o_ab);
+  addVectors5(entries, o_a, o_b, o_ab2);
+  addVectors4.run();
+
+  // addVectors also accumulates into the first entries, only check the last one
+  o_ab.copyTo(ab);
+  ASSERT_EQ(ab[entries - 1], (float) (2 * (entries - 1)));
+
+  // Freeing a cached kernel leaves the other kernels usable
+  addVectors4.free();
+  ASSERT_FALSE(addVectors4.isInitialized());
+  ASSERT_TRUE(addVectors5.isInitialized());
+  addVectors5(entries, o_a, o_b, o_ab2);
+  o_ab2.copyTo(ab);
+  ASSERT_EQ(ab[entries - 1], (float) (2 * (entries - 1)));
+
+  addVectors4 = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_TRUE(addVectors4.isInitialized());
+
+  // Editing the kernel file invalidates its cached kernels
+  const std::string setValueFile = (
+    occa::env::OCCA_CACHE_DIR + "kernel_cache_" + occa::hash_t::random().getString() + ".okl"
+  );
+  const std::string setValueSource = (
+    "@kernel void setValue(float *value) {\n"
+    "  for (int i = 0; i < 1; ++i; @outer) {\n"
+    "    for (int j = 0; j < 1; ++j; @inner) {\n"
+    "      value[0] = VALUE;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  occa::memory o_value = device.malloc<float>(1);
+  float value = 0;
+
+  occa::io::write(setValueFile, "#define VALUE 1\n" + setValueSource);
+  device.buildKernel(setValueFile, "setValue")(o_value);
+  o_value.copyTo(&value);
+  ASSERT_EQ(value, (float) 1);
+
+  occa::io::write(setValueFile, "#define VALUE 20\n" + setValueSource);
+  device.buildKernel(setValueFile, "setValue")(o_value);
+  o_value.copyTo(&value);
+  ASSERT_EQ(value, (float) 20);
+
+  occa::sys::rmrf(setValueFile);
+
+  device.clearKernelCache();
+  ASSERT_EQ((int) device.kernelCacheStats()["size"], 0);
+}
+
+void testBuildKernels() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+
+  std::vector<occa::kernelBuildInfo> kernelInfos;
+  kernelInfos.push_back(occa::kernelBuildInfo(addVectorsFile, "addVectors", {
+    {"defines/BUILD_KERNELS_ID", 0}
+  }));
+  kernelInfos.push_back(occa::kernelBuildInfo(addVectorsFile, "addVectors", {
+    {"defines/BUILD_KERNELS_ID", 1}
+  }));
+  kernelInfos.push_back(occa::kernelBuildInfo(addVectorsFile, "addVectors", {
+    {"defines/BUILD_KERNELS_ID", 0}
+  }));
+
+  std::vector<occa::kernel> kernels = device.buildKernels(kernelInfos);
+  ASSERT_EQ((int) kernels.size(), 3);
+  ASSERT_TRUE(kernels[0].isInitialized());
+  ASSERT_TRUE(kernels[1].isInitialized());
+  ASSERT_TRUE(kernels[0] != kernels[1]);
+
+  // Duplicates are only built once but are still separate kernels
+  ASSERT_TRUE(kernels[0] != kernels[2]);
+  ASSERT_EQ(kernels[0].binaryFilename(), kernels[2].binaryFilename());
+
+  // Built kernels are added to the in-process cache
+  const int cacheHits = (int) device.kernelCacheStats()["hits"];
+  occa::kernel cachedKernel = device.buildKernel(addVectorsFile, "addVectors", {
+    {"defines/BUILD_KERNELS_ID", 1}
+  });
+  ASSERT_EQ((int) device.kernelCacheStats()["hits"], cacheHits + 1);
+  ASSERT_EQ(kernels[1].binaryFilename(), cachedKernel.binaryFilename());
+
+  const int entries = 5;
+  float *ab = new float[entries];
+  for (int i = 0; i < entries; ++i) {
+    ab[i] = i;
+  }
+  occa::memory o_a = device.malloc<float>(entries, ab);
+  occa::memory o_b = device.malloc<float>(entries, ab);
+  occa::memory o_ab = device.malloc<float>(entries);
+
+  // addVectors also accumulates into the first entries, only check the last one
+  for (occa::kernel &addVectors : kernels) {
+    addVectors(entries, o_a, o_b, o_ab);
+    o_ab.copyTo(ab);
+    ASSERT_EQ(ab[entries - 1], (float) (2 * (entries - 1)));
+  }
+
+  delete [] ab;
+}
+
+void testMemoryPool() {
+  occa::device device({
+    {"mode", "Serial"},
+    {"memory_pool", true}
+  });
+
+  occa::memory mem = device.malloc<float>(1000);
+  const void *ptr = mem.ptr();
+  // 4000 bytes are rounded up to the 4096-byte size class
+  ASSERT_EQ((int) device.memoryAllocated(), 4096);
+  ASSERT_EQ((int) mem.size(), 4000);
+
+  // Freed buffers are reused by allocations in the same size class
+  mem.free();
+  ASSERT_EQ((int) device.memoryAllocated(), 4096);
+  ASSERT_EQ((int) device.memoryPoolStats()["bytes_idle"], 4096);
+
+  std::vector<float> values(1020);
+  for (int i = 0; i < (int) values.size(); ++i) {
+    values[i] = i + 1;
+  }
+  mem = device.malloc<float>(1020, values.data());
+  ASSERT_EQ(ptr, (const void*) mem.ptr());
+  ASSERT_EQ(mem.ptr<float>()[3], 4.0f);
+  ASSERT_EQ(mem.ptr<float>()[1019], 1020.0f);
+  ASSERT_EQ((int) device.memoryPoolStats()["hits"], 1);
+
+  // Dropping the last reference also returns the buffer
+  mem = occa::memory();
+  ASSERT_EQ((int) device.memoryPoolStats()["idle_buffers"], 1);
+
+  // Allocations with custom properties bypass the pool
+  occa::memory unpooled = device.malloc<float>(1000, {
+    {"memory_pool", false}
+  });
+  ASSERT_TRUE(ptr != (const void*) unpooled.ptr());
+  ASSERT_EQ((int) device.memoryPoolStats()["misses"], 1);
+  unpooled.free();
+
+  device.trimMemoryPool();
+  ASSERT_EQ((int) device.memoryAllocated(), 0);
+  ASSERT_EQ((int) device.maxMemoryAllocated(), 8096);
+  ASSERT_EQ((int) device.memoryPoolStats()["bytes_idle"], 0);
+}
+
+void testSymbolicDefines() {
+  occa::device device({
+    {"mode", "Serial"},
+    {"kernel", {
+      {"okl", {
+        {"symbolic_defines", true}
+      }}
+    }}
+  });
+
+  const std::string kernelSource = (
+    "@kernel void scale(const int entries, float *values) {\n"
+    "  for (int i = 0; i < entries; ++i; @tile(4, @outer, @inner)) {\n"
+    "    values[i] *= SCALE;\n"
+    "  }\n"
+    "}\n"
+  );
+
+  const int entries = 5;
+  float values[entries] = {1, 2, 3, 4, 5};
+  occa::memory o_values = device.malloc<float>(entries, values);
+
+  std::string translations[2];
+  for (int scale = 2; scale <= 3; ++scale) {
+    occa::kernel scaleKernel = device.buildKernelFromString(kernelSource, "scale", {
+      {"defines/SCALE", scale}
+    });
+    scaleKernel(entries, o_values);
+
+    // Only the define header differs between variants
+    const std::string source = occa::io::read(
+      occa::io::dirname(scaleKernel.binaryFilename()) + occa::kc::sourceFile
+    );
+    const std::string header = "#define  SCALE " + occa::toString(scale) + "\n";
+    ASSERT_EQ(source.substr(0, header.size()), header);
+    translations[scale - 2] = source.substr(header.size());
+  }
+  ASSERT_EQ(translations[0], translations[1]);
+  ASSERT_NEQ(translations[0].find("SCALE"), std::string::npos);
+
+  o_values.copyTo(values);
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(values[i], (float) (6 * (i + 1)));
+  }
+
+  // Defines used in preprocessor conditionals are expanded during translation
+  occa::kernel conditionalKernel = device.buildKernelFromString(
+    "#if SCALE > 2\n" + kernelSource + "#endif\n",
+    "scale",
+    {{"defines/SCALE", 3}}
+  );
+  const std::string conditionalSource = occa::io::read(
+    occa::io::dirname(conditionalKernel.binaryFilename()) + occa::kc::sourceFile
+  );
+  ASSERT_EQ(conditionalSource.find("SCALE"), std::string::npos);
+
+  // Also when they are used through other macros
+  const std::string macroSource = (
+    "#define DOUBLE_SCALE (SCALE * 2)\n"
+    "@kernel void setValues(const int entries, float *values) {\n"
+    "  for (int i = 0; i < entries; ++i; @tile(4, @outer, @inner)) {\n"
+    "#if DOUBLE_SCALE > 4\n"
+    "    values[i] = 1;\n"
+    "#else\n"
+    "    values[i] = 2;\n"
+    "#endif\n"
+    "  }\n"
+    "}\n"
+  );
+  for (int scale = 2; scale <= 3; ++scale) {
+    occa::kernel setValues = device.buildKernelFromString(macroSource, "setValues", {
+      {"defines/SCALE", scale}
+    });
+    setValues(entries, o_values);
+    o_values.copyTo(values);
+    ASSERT_EQ(values[0], (scale == 2) ? 2.0f : 1.0f);
+  }
+}
+
+void testPrecompiledPrelude() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+
+  const int entries = 5;
+  float ab[entries] = {0, 1, 2, 3, 4};
+  occa::memory o_a = device.malloc<float>(entries, ab);
+  occa::memory o_b = device.malloc<float>(entries, ab);
+  occa::memory o_ab = device.malloc<float>(entries);
+
+  for (int usePrelude = 0; usePrelude < 2; ++usePrelude) {
+    occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors", {
+      {"precompiled_header", (bool) usePrelude},
+      {"defines/PRECOMPILED_PRELUDE_ID", usePrelude}
+    });
+    addVectors(entries, o_a, o_b, o_ab);
+    o_ab.copyTo(ab);
+    ASSERT_EQ(ab[entries - 1], 8.0f);
+  }
+
+  std::vector<std::string> preludeDirs;
+  for (const std::string &dir : occa::io::directories(occa::io::cachePath())) {
+    if (occa::io::isFile(dir + "kernel_prelude.hpp.gch")
+        || occa::io::isFile(dir + "kernel_prelude.hpp.pch")) {
+      preludeDirs.push_back(dir);
+    }
+  }
+  ASSERT_FALSE(preludeDirs.empty());
+
+  // Precompiled preludes removed from the cache are rebuilt
+  for (const std::string &dir : preludeDirs) {
+    occa::sys::rmrf(dir);
+  }
+
+  // Kernels can opt into only including the kernel prelude
+  for (int includeOcca = 0; includeOcca < 2; ++includeOcca) {
+    occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors", {
+      {"serial/include_occa", (bool) includeOcca},
+      {"defines/PRECOMPILED_PRELUDE_ID", "id_" + occa::hash_t::random().getString()}
+    });
+    addVectors(entries, o_a, o_b, o_ab);
+    o_ab.copyTo(ab);
+    ASSERT_EQ(ab[entries - 1], 8.0f);
+
+    const std::string source = occa::io::read(
+      occa::io::dirname(addVectors.binaryFilename()) + occa::kc::sourceFile
+    );
+    ASSERT_EQ(includeOcca != 0,
+              source.find("#include <occa.hpp>") != std::string::npos);
+  }
+}
+
+void testBuildStats() {
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+  const std::string statsFile = (
+    occa::io::cachePath() + "build_stats_" + occa::hash_t::random().getString() + ".json"
+  );
+  ::setenv("OCCA_BUILD_STATS", statsFile.c_str(), 1);
+
+  occa::json props;
+  props["defines/BUILD_STATS_ID"] = "id_" + occa::hash_t::random().getString();
+
+  for (int build = 0; build < 2; ++build) {
+    occa::device device({
+      {"mode", "Serial"}
+    });
+
+    occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors", props);
+    occa::kernel addVectors2 = device.buildKernel(addVectorsFile, "addVectors", props);
+
+    // Kernels from the in-process cache aren't counted
+    occa::json stats = device.buildStats();
+    ASSERT_EQ((int) stats["kernels"], 1);
+    ASSERT_EQ((int) stats["builds"].size(), 1);
+    ASSERT_GT((double) stats["total_time"], 0.0);
+    ASSERT_GT((occa::udim_t) stats["binary_bytes"], (occa::udim_t) 0);
+
+    const occa::json &kernelStats = stats["builds"][0];
+    ASSERT_EQ((std::string) kernelStats["name"], "addVectors");
+    ASSERT_GT((double) kernelStats["load_time"], 0.0);
+
+    if (build == 0) {
+      // Built from scratch
+      ASSERT_EQ((int) stats["cache_misses"], 1);
+      ASSERT_FALSE((bool) kernelStats["cache_hit"]);
+      ASSERT_GT((double) kernelStats["parse_time"], 0.0);
+      ASSERT_GT((double) kernelStats["transform_time"], 0.0);
+      ASSERT_GT((double) kernelStats["compile_time"], 0.0);
+    } else {
+      // Loaded from the binary cached by the first device
+      ASSERT_EQ((int) stats["cache_hits"], 1);
+      ASSERT_TRUE((bool) kernelStats["cache_hit"]);
+      ASSERT_EQ((double) kernelStats["compile_time"], 0.0);
+    }
+
+    device.free();
+  }
+  ::unsetenv("OCCA_BUILD_STATS");
+
+  // Each freed device appends a line
+  std::stringstream ss(occa::io::read(statsFile));
+  std::string line;
+  int records = 0;
+  while (std::getline(ss, line)) {
+    occa::json record = occa::json::parse(line);
+    ASSERT_EQ((std::string) record["mode"], "Serial");
+    ASSERT_EQ((int) record["stats"]["kernels"], 1);
+    ++records;
+  }
+  ASSERT_EQ(records, 2);
+}
@@ -0,0 +1,242 @@
+#include <occa.hpp>
+
+#include <occa/internal/core/graph.hpp>
+#include <occa/internal/core/kernel.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+const std::string kernelSource = (
+  "@kernel void addValue(const int entries, const float value, float *values) {\n"
+  "  for (int i = 0; i < entries; ++i; @tile(16, @outer, @inner)) {\n"
+  "    values[i] += value;\n"
+  "  }\n"
+  "}\n"
+  "\n"
+  "@kernel void scale(const int entries, const float factor, float *values) {\n"
+  "  const int half = entries / 2;\n"
+  "  for (int i = 0; i < half; ++i; @outer) {\n"
+  "    for (int j = 0; j < 2; ++j; @inner) {\n"
+  "      values[2 * i + j] *= factor;\n"
+  "    }\n"
+  "  }\n"
+  "}\n"
+  "\n"
+  "@kernel void setFirst(const int entries, float *values) {\n"
+  "  values[0] = -1;\n"
+  "  for (int i = 0; i < entries; ++i; @outer) {\n"
+  "    for (int j = 0; j < 1; ++j; @inner) {}\n"
+  "  }\n"
+  "}\n"
+);
+
+void testCaptureErrors();
+void testReplay(occa::device device);
+void testAsyncReplay();
+void testKernelBindings();
+
+int main(const int argc, const char **argv) {
+  testCaptureErrors();
+
+  testReplay(occa::device({
+    {"mode", "Serial"}
+  }));
+  testReplay(occa::device({
+    {"mode", "OpenMP"}
+  }));
+
+  testAsyncReplay();
+  testKernelBindings();
+
+  return 0;
+}
+
+void testCaptureErrors() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  occa::graph graph;
+  ASSERT_FALSE(graph.isInitialized());
+  ASSERT_EQ(0, graph.size());
+  ASSERT_EQ("No Mode", graph.mode());
+  ASSERT_THROW(
+    graph.launch();
+  );
+
+  ASSERT_THROW(
+    device.endCapture();
+  );
+
+  ASSERT_FALSE(device.isCapturing());
+  device.beginCapture();
+  ASSERT_TRUE(device.isCapturing());
+
+  ASSERT_THROW(
+    device.beginCapture();
+  );
+
+  graph = device.endCapture();
+  ASSERT_FALSE(device.isCapturing());
+  ASSERT_TRUE(graph.isInitialized());
+  ASSERT_EQ(0, graph.size());
+  ASSERT_EQ(device, graph.getDevice());
+  ASSERT_EQ("Serial", graph.mode());
+
+  // Empty graphs can be launched
+  graph.launch();
+
+  graph.free();
+  ASSERT_FALSE(graph.isInitialized());
+}
+
+void testReplay(occa::device device) {
+  const int entries = 8;
+
+  occa::kernel addValue = device.buildKernelFromString(kernelSource, "addValue");
+  occa::kernel scale = device.buildKernelFromString(kernelSource, "scale");
+  occa::kernel setFirst = device.buildKernelFromString(kernelSource, "setFirst");
+
+  float input[entries];
+  float output[entries];
+  for (int i = 0; i < entries; ++i) {
+    input[i] = i;
+    output[i] = 0;
+  }
+
+  occa::memory values = device.malloc<float>(entries);
+  occa::memory valuesCopy = device.malloc<float>(entries);
+  values.copyFrom(input);
+
+  device.beginCapture();
+  values.copyFrom(input);
+  addValue(entries, 1.0f, values);
+  scale(entries, 2.0f, values);
+  valuesCopy.copyFrom(values);
+  setFirst(entries, valuesCopy);
+  addValue(entries, 0.5f, values);
+  values.copyTo(output);
+  occa::graph graph = device.endCapture();
+
+  ASSERT_EQ(7, graph.size());
+  ASSERT_EQ(device.mode(), graph.mode());
+
+  // Nothing runs while capturing
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(0, (int) output[i]);
+  }
+
+  for (int launch = 0; launch < 3; ++launch) {
+    // Host pointers are read when the graph is launched
+    input[0] = launch;
+
+    graph.launch();
+    device.finish();
+
+    for (int i = 0; i < entries; ++i) {
+      const float expectedValue = 2 * ((i ? i : launch) + 1) + 0.5;
+      ASSERT_EQ(expectedValue, output[i]);
+    }
+
+    float copyOutput[entries];
+    valuesCopy.copyTo(copyOutput);
+    ASSERT_EQ(-1, (int) copyOutput[0]);
+    for (int i = 1; i < entries; ++i) {
+      ASSERT_EQ(2 * (i + 1), (int) copyOutput[i]);
+    }
+  }
+
+  // Kernels with only @outer loops and declarations can share a parallel region
+  if (device.mode() == "OpenMP") {
+    void *dlHandle = occa::sys::dlopen(scale.binaryFilename());
+    ASSERT_NEQ((void*) NULL,
+               (void*) occa::sys::dlsym(dlHandle, "scale_occa_graph_launch", false));
+    occa::sys::dlclose(dlHandle);
+
+    dlHandle = occa::sys::dlopen(setFirst.binaryFilename());
+    ASSERT_EQ((void*) NULL,
+              (void*) occa::sys::dlsym(dlHandle, "setFirst_occa_graph_launch", false));
+    occa::sys::dlclose(dlHandle);
+  }
+
+  // Recorded argument types are validated once when they're captured
+  occa::memory intValues = device.malloc<int>(entries);
+  device.beginCapture();
+  ASSERT_THROW(
+    addValue(entries, 1.0f, intValues);
+  );
+  graph = device.endCapture();
+  ASSERT_EQ(0, graph.size());
+}
+
+void testAsyncReplay() {
+  const int entries = 8;
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  device.setStream(
+    device.createStream({{"async", true}})
+  );
+
+  occa::kernel addValue = device.buildKernelFromString(kernelSource, "addValue");
+
+  float zeros[entries] = {0, 0, 0, 0, 0, 0, 0, 0};
+  float output[entries];
+  occa::memory values = device.malloc<float>(entries);
+
+  device.beginCapture();
+  for (int i = 0; i < 4; ++i) {
+    addValue(entries, 1.0f, values);
+  }
+  values.copyTo(output);
+  occa::graph graph = device.endCapture();
+
+  values.copyFrom(zeros);
+
+  graph.launch();
+  graph.launch();
+  device.finish();
+
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(8, (int) output[i]);
+  }
+}
+
+void testKernelBindings() {
+  const int entries = 8;
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  occa::kernel addValue = device.buildKernelFromString(kernelSource, "addValue");
+
+  float zeros[entries] = {0, 0, 0, 0, 0, 0, 0, 0};
+  occa::memory values = device.malloc<float>(entries, zeros);
+  occa::memory otherValues = device.malloc<float>(entries, zeros);
+
+  // Use the replay shared by modes without their own graphs
+  occa::modeGraph_t *modeGraph = new occa::modeGraph_t(device.getModeDevice());
+  addValue.clearArgs();
+  addValue.pushArg(entries);
+  addValue.pushArg(1.0f);
+  addValue.pushArg(values);
+  modeGraph->addKernelNode(addValue.getModeKernel());
+  modeGraph->finalize();
+
+  // Launching the graph keeps the arguments set on the kernel
+  addValue.clearArgs();
+  addValue.pushArg(entries);
+  addValue.pushArg(2.0f);
+  addValue.pushArg(otherValues);
+  modeGraph->launch();
+  addValue.run();
+  device.finish();
+
+  float output[entries];
+  values.copyTo(output);
+  ASSERT_EQ(1, (int) output[0]);
+  otherValues.copyTo(output);
+  ASSERT_EQ(2, (int) output[0]);
+
+  delete modeGraph;
+}
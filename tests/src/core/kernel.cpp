@@ -2,6 +2,7 @@
 
 #include <occa/internal/io.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/core/kernel.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 occa::kernel addVectors;
@@ -14,6 +15,7 @@ void testInfo();
 void testParsingFailure();
 void testCompilingFailure();
 void testArgumentFailure();
+void testArgumentValidationCache();
 void testRun();
 
 int main(const int argc, const char **argv) {
@@ -25,6 +27,7 @@ int main(const int argc, const char **argv) {
   testParsingFailure();
   testCompilingFailure();
   testArgumentFailure();
+  testArgumentValidationCache();
   testRun();
 
   return 0;
@@ -148,6 +151,40 @@ void testArgumentFailure() {
   );
 }
 
+void testArgumentValidationCache() {
+  occa::kernel kernel = occa::buildKernelFromString(
+    "@kernel void foo(int N, float *arg) {"
+    "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {"
+    "    arg[i] = i;"
+    "  }"
+    "}",
+    "foo"
+  );
+
+  const int N = 10;
+  occa::memory floatArg = occa::malloc<float>(N);
+  occa::memory intArg = occa::malloc<int>(N);
+
+  // Validated argument types are reused across launches
+  kernel(N, floatArg);
+  ASSERT_TRUE(kernel.getModeKernel()->hasValidatedArgTypes);
+  kernel(N, floatArg);
+
+  float values[N];
+  floatArg.copyTo(values);
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(values[i], (float) i);
+  }
+
+  // Different argument types are validated again
+  ASSERT_THROW(
+    kernel(N, intArg);
+  );
+  ASSERT_THROW(
+    kernel(N, occa::null, N);
+  );
+}
+
 void testRun() {
   std::string argKernelFile = (
     occa::env::OCCA_DIR + "tests/files/argKernel.okl"
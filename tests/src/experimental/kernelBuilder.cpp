@@ -0,0 +1,122 @@
+#include <occa.hpp>
+#include <occa/experimental.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testRun();
+void testScopeHash();
+
+int main(const int argc, const char **argv) {
+  occa::setDevice(occa::host());
+
+  testRun();
+  testScopeHash();
+
+  return 0;
+}
+
+void testRun() {
+  int values[4] = {0, 0, 0, 0};
+  occa::memory mem = occa::malloc<int>(4, values);
+
+  occa::kernelBuilder builder(
+    "for (int i = 0; i < 4; ++i; @tile(4, @outer, @inner)) {"
+    "  values[i] += value;"
+    "}",
+    "addValue"
+  );
+
+  // Repeat launches reuse the launch plan
+  for (int i = 0; i < 3; ++i) {
+    builder.run({
+      {"values", mem},
+      {"value", 1}
+    });
+  }
+
+  // Same signature with the arguments listed in a different order
+  builder.run({
+    {"value", 2},
+    {"values", mem}
+  });
+
+  mem.copyTo(values);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(5, values[i]);
+  }
+
+  ASSERT_THROW(
+    builder.run({{"values", mem}})
+  );
+
+  builder.free();
+}
+
+void testScopeHash() {
+  int value = 1;
+  occa::scope scope({
+    {"value", value}
+  });
+  const occa::hash_t hash = scope.hash();
+  ASSERT_EQ(hash, scope.hash());
+
+  // Copies keep the memoized hash
+  occa::scope scopeCopy = scope;
+  ASSERT_TRUE(scopeCopy.hasCachedHash());
+  ASSERT_EQ(hash, scopeCopy.hash());
+
+  // Editing props or args resets the hash
+  scope.setProp("defines/FOO", 1);
+  ASSERT_FALSE(scope.hasCachedHash());
+  ASSERT_NEQ(hash, scope.hash());
+
+  const occa::hash_t propsHash = scope.hash();
+  scope.add("other", value);
+  ASSERT_FALSE(scope.hasCachedHash());
+  ASSERT_NEQ(propsHash, scope.hash());
+
+  scope.addProps({{"defines/BAR", 1}});
+  ASSERT_FALSE(scope.hasCachedHash());
+
+  // Repeat launches reuse the hash from the first launch
+  int values[4] = {0, 0, 0, 0};
+  occa::memory mem = occa::malloc<int>(4, values);
+  occa::scope launchScope({
+    {"values", mem},
+    {"value", 1}
+  });
+  occa::kernelBuilder builder(
+    "for (int i = 0; i < 4; ++i; @tile(4, @outer, @inner)) {"
+    "  values[i] += value;"
+    "}",
+    "addValue"
+  );
+  ASSERT_FALSE(launchScope.hasCachedHash());
+  builder.run(launchScope);
+  ASSERT_TRUE(launchScope.hasCachedHash());
+
+  const occa::hash_t launchHash = launchScope.hash();
+  builder.run(launchScope);
+  ASSERT_TRUE(launchScope.hasCachedHash());
+  ASSERT_EQ(launchHash, launchScope.hash());
+
+  mem.copyTo(values);
+  ASSERT_EQ(2, values[0]);
+  builder.free();
+
+  // Launches through the same call site pick up edited defines
+  int output = 0;
+  occa::memory o_output = occa::malloc<int>(1, &output);
+  occa::scope jitScope({
+    {"output", o_output}
+  });
+  for (int i = 1; i <= 2; ++i) {
+    jitScope.setProp("defines/VALUE", i);
+    OCCA_JIT(jitScope, (
+      for (int j = 0; j < 1; ++j; @tile(1, @outer, @inner)) {
+        output[j] = VALUE;
+      }
+    ));
+    o_output.copyTo(&output);
+    ASSERT_EQ(i, output);
+  }
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <occa.hpp>
 #include <occa/functional.hpp>
 #include <occa/internal/functional/functionStore.hpp>
@@ -45,6 +47,13 @@ void testForEach(occa::device device);
 void testMap(occa::device device);
 void testMapTo(occa::device device);
 void testReduce(occa::device device);
+void testReduceAsync(occa::device device);
+void testReduceMany(occa::device device);
+void testMapReduce(occa::device device);
+void testScan(occa::device device);
+void testPartition(occa::device device);
+void testSort(occa::device device);
+void testHostView(occa::device device);
 void testSlice(occa::device device);
 void testConcat(occa::device device);
 void testFill(occa::device device);
@@ -59,6 +68,8 @@ void testMax(occa::device device);
 void testMin(occa::device device);
 void testDotProduct(occa::device device);
 void testClamp(occa::device device);
+void testLengthSpecialization(occa::device device);
+void testLazy(occa::device device);
 
 int main(const int argc, const char **argv) {
   std::vector<occa::device> devices = {
@@ -91,6 +102,13 @@ int main(const int argc, const char **argv) {
     testMap(device);
     testMapTo(device);
     testReduce(device);
+    testReduceAsync(device);
+    testReduceMany(device);
+    testMapReduce(device);
+    testScan(device);
+    testPartition(device);
+    testSort(device);
+    testHostView(device);
     testSlice(device);
     testConcat(device);
     testFill(device);
@@ -105,6 +123,8 @@ int main(const int argc, const char **argv) {
     testMin(device);
     testDotProduct(device);
     testClamp(device);
+    testLengthSpecialization(device);
+    testLazy(device);
   }
 
   return 0;
@@ -290,7 +310,6 @@ void testSome(occa::device device) {
 }
 
 void testFilter(occa::device device) {
-#if 0
   context ctx(device);
 
   occa::array<int> filteredArray;
@@ -339,7 +358,6 @@ void testFilter(occa::device device) {
   ASSERT_EQ(5, (int) filteredArray.length());
   ASSERT_EQ(5, filteredArray.min());
   ASSERT_EQ(ctx.maxValue, filteredArray.max());
-#endif
 }
 
 void testFindIndex(occa::device device) {
@@ -599,6 +617,367 @@ void testReduce(occa::device device) {
   );
 }
 
+void testReduceAsync(occa::device device) {
+  const int length = 10000;
+  int *values = new int[length];
+  int sum = 0;
+  for (int i = 0; i < length; ++i) {
+    values[i] = (i * 7) % 1000;
+    sum += values[i];
+  }
+
+  occa::array<int> array(device.malloc<int>(length, values));
+
+  // Queue multiple reductions before synchronizing
+  occa::asyncValue<int> asyncSum = array.reduceAsync<int>(
+    occa::reductionType::sum,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc + value;
+    })
+  );
+  occa::asyncValue<int> asyncMin = array.reduceAsync<int>(
+    occa::reductionType::min,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc < value ? acc : value;
+    })
+  );
+  occa::asyncValue<int> asyncMax = array.reduceAsync<int>(
+    occa::reductionType::max,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc > value ? acc : value;
+    })
+  );
+
+  ASSERT_TRUE(asyncSum.isInitialized());
+  ASSERT_EQ(sum, asyncSum.get());
+  ASSERT_EQ(0, asyncMin.get());
+  ASSERT_EQ(999, asyncMax.get());
+
+  ASSERT_EQ(
+    sum,
+    array.reduce<int>(
+      occa::reductionType::sum,
+      OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+        return acc + value;
+      })
+    )
+  );
+
+  delete [] values;
+}
+
+void testReduceMany(occa::device device) {
+  const int length = 10000;
+  double *values = new double[length];
+  double sum = 0;
+  for (int i = 0; i < length; ++i) {
+    values[i] = ((i * 7) % 1000) - 500;
+    sum += values[i];
+  }
+
+  occa::array<double> array(device.malloc<double>(length, values));
+
+  std::vector<double> reductions = array.reduceMany({
+    occa::reductionType::min,
+    occa::reductionType::max,
+    occa::reductionType::sum
+  });
+
+  ASSERT_EQ(3, (int) reductions.size());
+  ASSERT_EQ(-500.0, reductions[0]);
+  ASSERT_EQ(499.0, reductions[1]);
+  ASSERT_EQ(sum, reductions[2]);
+
+  context ctx(device);
+  std::vector<int> smallReductions = ctx.array.reduceMany({
+    occa::reductionType::max,
+    occa::reductionType::min
+  });
+  ASSERT_EQ(ctx.maxValue, smallReductions[0]);
+  ASSERT_EQ(ctx.minValue, smallReductions[1]);
+
+  delete [] values;
+}
+
+void testMapReduce(occa::device device) {
+  context ctx(device);
+
+  int sumOfSquares = 0;
+  for (int i = 0; i < ctx.length; ++i) {
+    sumOfSquares += ctx.values[i] * ctx.values[i];
+  }
+
+  ASSERT_EQ(
+    sumOfSquares,
+    ctx.array.mapReduce<int>(
+      OCCA_FUNCTION([](const int &value) -> int {
+        return value * value;
+      }),
+      occa::reductionType::sum
+    )
+  );
+
+  ASSERT_EQ(
+    (float) (ctx.maxValue * ctx.maxValue),
+    ctx.array.mapReduce<float>(
+      OCCA_FUNCTION([](const int &value, const int index) -> float {
+        return value * index;
+      }),
+      occa::reductionType::max
+    )
+  );
+
+  const int mapReduceValue = ctx.array.mapReduce(
+    OCCA_FUNCTION([](const int &value) -> int {
+      return value * value;
+    }),
+    occa::reductionType::sum,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc + value;
+    })
+  );
+  ASSERT_EQ(sumOfSquares, mapReduceValue);
+
+  // Mapped values can be outside the range of the source values
+  ASSERT_EQ(
+    ctx.maxValue - 100,
+    ctx.array.mapReduce<int>(
+      OCCA_FUNCTION([](const int &value) -> int {
+        return value - 100;
+      }),
+      occa::reductionType::max
+    )
+  );
+
+  ASSERT_EQ(
+    100 - ctx.maxValue,
+    ctx.array.mapReduce<int>(
+      OCCA_FUNCTION([](const int &value) -> int {
+        return 100 - value;
+      }),
+      occa::reductionType::min
+    )
+  );
+
+  const int mapReduceMaxValue = ctx.array.mapReduce(
+    OCCA_FUNCTION([](const int &value) -> int {
+      return value - 100;
+    }),
+    occa::reductionType::max,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc > value ? acc : value;
+    })
+  );
+  ASSERT_EQ(ctx.maxValue - 100, mapReduceMaxValue);
+}
+
+void testScan(occa::device device) {
+  const int length = 10000;
+  int *values = new int[length];
+  for (int i = 0; i < length; ++i) {
+    values[i] = ((i * 7) % 13) - 6;
+  }
+
+  occa::array<int> array(device.malloc<int>(length, values));
+
+  int *inclusiveSums = new int[length];
+  int *exclusiveSums = new int[length];
+  int *inclusiveMaxes = new int[length];
+  array.inclusiveScan().copyTo(inclusiveSums);
+  array.exclusiveScan(occa::reductionType::sum, 3).copyTo(exclusiveSums);
+  array.inclusiveScan(occa::reductionType::max).copyTo(inclusiveMaxes);
+
+  int sum = 0;
+  int max = values[0];
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(3 + sum, exclusiveSums[i]);
+    sum += values[i];
+    max = std::max(max, values[i]);
+    ASSERT_EQ(sum, inclusiveSums[i]);
+    ASSERT_EQ(max, inclusiveMaxes[i]);
+  }
+
+  context ctx(device);
+  int smallSums[10];
+  ctx.array.exclusiveScan().copyTo(smallSums);
+  for (int i = 0; i < ctx.length; ++i) {
+    ASSERT_EQ(i * (i - 1) / 2, smallSums[i]);
+  }
+
+  delete [] values;
+  delete [] inclusiveSums;
+  delete [] exclusiveSums;
+  delete [] inclusiveMaxes;
+}
+
+void testPartition(occa::device device) {
+  context ctx(device);
+
+  std::pair<occa::array<int>, occa::array<int>> parts = (
+    ctx.array
+    .partition(OCCA_FUNCTION([](const int &value) -> bool {
+      return value % 3 == 0;
+    }))
+  );
+
+  ASSERT_EQ(4, (int) parts.first.length());
+  ASSERT_EQ(6, (int) parts.second.length());
+
+  int trues[4];
+  int falses[6];
+  parts.first.copyTo(trues);
+  parts.second.copyTo(falses);
+
+  const int expectedTrues[4] = {0, 3, 6, 9};
+  const int expectedFalses[6] = {1, 2, 4, 5, 7, 8};
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(expectedTrues[i], trues[i]);
+  }
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(expectedFalses[i], falses[i]);
+  }
+
+  // Large enough to span every scan thread
+  const int length = 10000;
+  occa::array<int> array(device, length);
+  array.fill(1);
+  occa::array<int> odds = (
+    array
+    .map(OCCA_FUNCTION([](const int &value, const int index) -> int {
+      return index;
+    }))
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return value % 2;
+    }))
+  );
+
+  ASSERT_EQ(length / 2, (int) odds.length());
+  ASSERT_EQ(1, odds.min());
+  ASSERT_EQ(length - 1, odds.max());
+  ASSERT_EQ(length - 1, odds[length / 2 - 1]);
+}
+
+void testSort(occa::device device) {
+  const int length = 5000;
+  int *intValues = new int[length];
+  float *floatValues = new float[length];
+  int *indices = new int[length];
+  for (int i = 0; i < length; ++i) {
+    intValues[i] = ((i * 7919) % 2003) - 1000;
+    floatValues[i] = 0.5f * (float) (((i * 104729) % 1999) - 999);
+    indices[i] = i;
+  }
+
+  occa::array<int> intArray(device.malloc<int>(length, intValues));
+  occa::array<float> floatArray(device.malloc<float>(length, floatValues));
+  occa::array<int> indexArray(device.malloc<int>(length, indices));
+
+  std::vector<int> expectedInts(intValues, intValues + length);
+  std::vector<float> expectedFloats(floatValues, floatValues + length);
+  std::sort(expectedInts.begin(), expectedInts.end());
+  std::sort(expectedFloats.begin(), expectedFloats.end());
+
+  int *sortedInts = new int[length];
+  float *sortedFloats = new float[length];
+
+  intArray.sort().copyTo(sortedInts);
+  floatArray.sort().copyTo(sortedFloats);
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(expectedInts[i], sortedInts[i]);
+    ASSERT_EQ(expectedFloats[i], sortedFloats[i]);
+  }
+
+  // 8-byte keys use all of their bits
+  double *doubleValues = new double[length];
+  for (int i = 0; i < length; ++i) {
+    doubleValues[i] = 1e300 * (((i * 104729) % 1999) - 999);
+  }
+  occa::array<double> doubleArray(device.malloc<double>(length, doubleValues));
+  std::vector<double> expectedDoubles(doubleValues, doubleValues + length);
+  std::sort(expectedDoubles.begin(), expectedDoubles.end());
+
+  doubleArray.sort().copyTo(doubleValues);
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(expectedDoubles[i], doubleValues[i]);
+  }
+  delete [] doubleValues;
+
+  // Custom comparators
+  intArray
+    .sort(OCCA_FUNCTION([](const int &a, const int &b) -> bool {
+      return a > b;
+    }))
+    .copyTo(sortedInts);
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(expectedInts[length - i - 1], sortedInts[i]);
+  }
+
+  // Values follow their keys
+  std::pair<occa::array<int>, occa::array<int>> sortedPairs = intArray.sortByKey(indexArray);
+  int *sortedIndices = new int[length];
+  sortedPairs.first.copyTo(sortedInts);
+  sortedPairs.second.copyTo(sortedIndices);
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(expectedInts[i], sortedInts[i]);
+    ASSERT_EQ(sortedInts[i], intValues[sortedIndices[i]]);
+    if (i && (sortedInts[i] == sortedInts[i - 1])) {
+      ASSERT_LT(sortedIndices[i - 1], sortedIndices[i]);
+    }
+  }
+
+  // Segments [0, 1000), [1000, 1000), [1000, 3500), [3500, 5000)
+  int offsets[5] = {0, 1000, 1000, 3500, length};
+  occa::array<int> offsetArray(device.malloc<int>(5, offsets));
+  intArray.segmentedSort(offsetArray).copyTo(sortedInts);
+  for (int segment = 0; segment < 4; ++segment) {
+    std::sort(intValues + offsets[segment], intValues + offsets[segment + 1]);
+  }
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(intValues[i], sortedInts[i]);
+  }
+
+  delete [] intValues;
+  delete [] floatValues;
+  delete [] indices;
+  delete [] sortedInts;
+  delete [] sortedFloats;
+  delete [] sortedIndices;
+}
+
+void testHostView(occa::device device) {
+  context ctx(device);
+
+  {
+    occa::hostView<int> view = ctx.array.hostView(2, 5);
+    ASSERT_EQ(5, (int) view.length());
+    ASSERT_EQ(!device.hasSeparateMemorySpace(), view.isZeroCopy());
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_EQ(i + 2, view[i]);
+      view[i] *= 10;
+    }
+  }
+
+  for (int i = 0; i < ctx.length; ++i) {
+    const int expected = (2 <= i && i < 7) ? (10 * i) : i;
+    ASSERT_EQ(expected, ctx.array[i]);
+  }
+
+  occa::hostView<int> view = ctx.array.hostView(0, -1, occa::hostAccess::write);
+  ASSERT_EQ(ctx.length, (int) view.length());
+  for (int &value : view) {
+    value = 1;
+  }
+  view.release();
+  ASSERT_FALSE(view.isInitialized());
+
+  ASSERT_EQ(ctx.length, ctx.array.reduce<int>(
+    occa::reductionType::sum,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc + value;
+    })
+  ));
+}
+
 void testSlice(occa::device device) {
   context ctx(device);
 
@@ -906,3 +1285,102 @@ void testClamp(occa::device device) {
   ASSERT_EQ(0, clampedArray.min());
   ASSERT_EQ(7, clampedArray.max());
 }
+
+void testLengthSpecialization(occa::device device) {
+  // Devices can share modes so each run uses new kernels
+  occa::scope scope({}, {
+    {"defines/OCCA_TEST_ID", "id_" + occa::hash_t::random().getString()}
+  });
+  occa::function<void(const int&, const int)> fn = OCCA_FUNCTION(
+    scope, [](const int &value, const int index) -> void {}
+  );
+
+  auto forEachLength = [&](const bool lengthSpecialization) {
+    const int kernelCount = device.buildStats().get("kernels", 0);
+    for (int length = 1; length < 5; ++length) {
+      occa::array<int> array(device, length);
+      array.setTileSize(4, 2);
+      array.setLengthSpecialization(lengthSpecialization);
+      array.forEach(fn);
+    }
+    return device.buildStats().get("kernels", 0) - kernelCount;
+  };
+
+  // Tiling values are kernel arguments by default
+  ASSERT_EQ(1, forEachLength(false));
+  ASSERT_EQ(0, forEachLength(false));
+
+  // Specialized kernels are built for each length's tiling
+  ASSERT_LT(1, forEachLength(true));
+
+  occa::array<int> array(device, 3);
+  array.setLengthSpecialization(true);
+  ASSERT_TRUE(array.usingLengthSpecialization());
+  array.fill(2);
+  ASSERT_EQ(2, array.max());
+}
+
+void testLazy(occa::device device) {
+  context ctx(device);
+
+  occa::lazyArray<float> lazyValues = (
+    ctx.array
+    .lazy()
+    .map(OCCA_FUNCTION([](const int &value, const int index) -> float {
+      return value + index + 0.5;
+    }))
+    .clampMin(2)
+    .map(OCCA_FUNCTION([](const float &value) -> float {
+      return value / 2;
+    }))
+    .clamp(1.5, 6)
+  );
+  ASSERT_EQ(4, lazyValues.stageCount());
+  ASSERT_EQ(ctx.length, (int) lazyValues.length());
+
+  // Only the fused kernel runs
+  const int kernelCount = device.buildStats().get("kernels", 0);
+  occa::array<float> values = lazyValues.eval();
+  ASSERT_LE(device.buildStats().get("kernels", 0) - kernelCount, 1);
+
+  ASSERT_EQ(ctx.length, (int) values.length());
+  for (int i = 0; i < ctx.length; ++i) {
+    float expected = (2 * i + 0.5) < 2 ? 2 : (2 * i + 0.5);
+    expected /= 2;
+    expected = expected > 6 ? 6 : (expected < 1.5 ? 1.5 : expected);
+    ASSERT_EQ(expected, values[i]);
+  }
+
+  ASSERT_EQ((float) 6, lazyValues.max());
+  ASSERT_EQ((float) 1.5, lazyValues.min());
+  ASSERT_EQ(
+    values.reduce<float>(
+      occa::reductionType::sum,
+      OCCA_FUNCTION([](const float &acc, const float &value) -> float {
+        return acc + value;
+      })
+    ),
+    lazyValues.reduce<float>(
+      occa::reductionType::sum,
+      OCCA_FUNCTION([](const float &acc, const float &value) -> float {
+        return acc + value;
+      })
+    )
+  );
+
+  // Assigning to the source array writes in-place
+  occa::array<int> ints = ctx.array.clone();
+  ints = ints.lazy().clampMin(3).clampMax(6);
+  ASSERT_EQ(3, ints.min());
+  ASSERT_EQ(6, ints.max());
+  ASSERT_EQ(ctx.length, (int) ints.length());
+
+  occa::array<int> converted = ctx.array.lazy().clampMax(4);
+  ASSERT_EQ(4, converted.max());
+  ASSERT_EQ(0, converted.min());
+
+  // No stages is a copy
+  occa::array<int> copy = ctx.array.lazy().eval();
+  ASSERT_NEQ(ctx.array.memory(), copy.memory());
+  ASSERT_EQ(ctx.maxValue, copy.max());
+}
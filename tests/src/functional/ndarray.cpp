@@ -0,0 +1,380 @@
+#include <occa.hpp>
+#include <occa/functional.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+typedef occa::ndarray<int, 2> intMatrix;
+
+void testStrides();
+void testViews(occa::device device);
+void testCopy(occa::device device);
+void testMap(occa::device device);
+void testFill(occa::device device);
+void testReduce(occa::device device);
+void testHighDimensions(occa::device device);
+void testDimAttributes(occa::device device);
+
+int main(const int argc, const char **argv) {
+  std::vector<occa::device> devices = {
+    occa::device({
+      {"mode", "Serial"}
+    }),
+    occa::device({
+      {"mode", "OpenMP"}
+    })
+  };
+
+  testStrides();
+
+  for (auto &device : devices) {
+    std::cout << "Testing mode: " << device.mode() << '\n';
+    testViews(device);
+    testCopy(device);
+    testMap(device);
+    testFill(device);
+    testReduce(device);
+    testHighDimensions(device);
+    testDimAttributes(device);
+  }
+
+  return 0;
+}
+
+occa::ndarray<int, 2> getIndexMatrix(occa::device device,
+                                     const int rows,
+                                     const int columns,
+                                     const occa::ndarrayLayout layout = occa::ndarrayLayout::rowMajor,
+                                     const int alignment = 1) {
+  std::vector<int> values(rows * columns);
+  for (int i = 0; i < (rows * columns); ++i) {
+    values[i] = i;
+  }
+
+  occa::ndarray<int, 2> matrix(device, {rows, columns}, layout, alignment);
+  matrix.copyFrom(values.data());
+  return matrix;
+}
+
+void testStrides() {
+  const occa::dimVector shape = {2, 3, 5};
+
+  occa::dimVector strides = occa::typelessNdarray::getStrides(
+    shape, occa::ndarrayLayout::rowMajor
+  );
+  ASSERT_EQ(15, (int) strides[0]);
+  ASSERT_EQ(5, (int) strides[1]);
+  ASSERT_EQ(1, (int) strides[2]);
+
+  strides = occa::typelessNdarray::getStrides(
+    shape, occa::ndarrayLayout::columnMajor
+  );
+  ASSERT_EQ(1, (int) strides[0]);
+  ASSERT_EQ(2, (int) strides[1]);
+  ASSERT_EQ(6, (int) strides[2]);
+
+  // Only the leading dimension is padded
+  strides = occa::typelessNdarray::getStrides(
+    shape, occa::ndarrayLayout::rowMajor, 4
+  );
+  ASSERT_EQ(24, (int) strides[0]);
+  ASSERT_EQ(8, (int) strides[1]);
+  ASSERT_EQ(1, (int) strides[2]);
+
+  strides = occa::typelessNdarray::getStrides(
+    shape, occa::ndarrayLayout::columnMajor, 4
+  );
+  ASSERT_EQ(1, (int) strides[0]);
+  ASSERT_EQ(4, (int) strides[1]);
+  ASSERT_EQ(12, (int) strides[2]);
+
+  ASSERT_THROW(
+    occa::typelessNdarray::getStrides(shape, occa::ndarrayLayout::rowMajor, 0);
+  );
+}
+
+void testViews(occa::device device) {
+  occa::ndarray<int, 2> matrix = getIndexMatrix(device, 4, 6);
+  ASSERT_EQ(2, matrix.dims());
+  ASSERT_EQ(24, (int) matrix.size());
+  ASSERT_TRUE(matrix.isContiguous());
+  ASSERT_TRUE(matrix.isRowMajor());
+
+  const occa::dimVector shape3d = {2, 3, 4};
+  ASSERT_THROW(
+    intMatrix(device, shape3d);
+  );
+
+  // Rows 1 and 2, every other column starting at column 1
+  occa::ndarray<int, 2> view = matrix.slice(0, 1, 2).slice(1, 1, -1, 2);
+  ASSERT_EQ(2, (int) view.shape(0));
+  ASSERT_EQ(3, (int) view.shape(1));
+  ASSERT_EQ(6, (int) view.stride(0));
+  ASSERT_EQ(2, (int) view.stride(1));
+  ASSERT_EQ(7, (int) view.offset());
+  ASSERT_EQ(11, (int) view.span());
+  ASSERT_FALSE(view.isContiguous());
+  ASSERT_FALSE(view.isRowMajor());
+
+  // Views share the memory
+  ASSERT_EQ(matrix.dataMemory().ptr<int>() + 7,
+            view.dataMemory().ptr<int>());
+
+  int viewValues[6];
+  view.copyTo(viewValues);
+  const int expectedViewValues[6] = {7, 9, 11, 13, 15, 17};
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(expectedViewValues[i], viewValues[i]);
+  }
+
+  occa::ndarray<int, 2> transposed = matrix.transpose();
+  ASSERT_EQ(6, (int) transposed.shape(0));
+  ASSERT_EQ(4, (int) transposed.shape(1));
+  ASSERT_EQ(1, (int) transposed.stride(0));
+  ASSERT_EQ(6, (int) transposed.stride(1));
+
+  int transposedValues[24];
+  transposed.copyTo(transposedValues);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_EQ(j * 6 + i, transposedValues[i * 4 + j]);
+    }
+  }
+
+  ASSERT_THROW(
+    matrix.slice(2, 0);
+  );
+  ASSERT_THROW(
+    matrix.slice(0, 5);
+  );
+  ASSERT_THROW(
+    matrix.slice(0, 1, 4);
+  );
+  ASSERT_THROW(
+    matrix.slice(0, 0, -1, 0);
+  );
+}
+
+void testCopy(occa::device device) {
+  // Padded column-major values are still read and written in row-major order
+  occa::ndarray<int, 2> matrix = getIndexMatrix(
+    device, 3, 5, occa::ndarrayLayout::columnMajor, 4
+  );
+  ASSERT_EQ(1, (int) matrix.stride(0));
+  ASSERT_EQ(4, (int) matrix.stride(1));
+  ASSERT_FALSE(matrix.isContiguous());
+
+  occa::array<int> values = matrix.toArray();
+  ASSERT_EQ(15, (int) values.length());
+  for (int i = 0; i < 15; ++i) {
+    ASSERT_EQ(i, values[i]);
+  }
+
+  occa::ndarray<int, 2> clone = matrix.clone();
+  ASSERT_TRUE(clone.isRowMajor());
+  ASSERT_NEQ(matrix.dataMemory().ptr<int>(),
+             clone.dataMemory().ptr<int>());
+
+  // Copy between views
+  occa::ndarray<int, 2> output(device, {5, 3});
+  output.fill(-1);
+  output.slice(0, 1, 2).copyFrom(
+    matrix.transpose().slice(0, 3)
+  );
+
+  int outputValues[15];
+  output.copyTo(outputValues);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const int expectedValue = (
+        (i == 1 || i == 2)
+        ? j * 5 + (i + 2)
+        : -1
+      );
+      ASSERT_EQ(expectedValue, outputValues[i * 3 + j]);
+    }
+  }
+
+  ASSERT_THROW(
+    output.copyFrom(matrix);
+  );
+
+  // Wrap existing memory
+  occa::memory mem = device.malloc<int>(15);
+  occa::ndarray<int, 2> wrapped(mem, {3, 5});
+  wrapped.copyFrom(matrix);
+  ASSERT_EQ(14, wrapped.max());
+
+  const occa::dimVector largerShape = {4, 5};
+  ASSERT_THROW(
+    intMatrix(mem, largerShape);
+  );
+}
+
+void testMap(occa::device device) {
+  occa::ndarray<int, 2> matrix = getIndexMatrix(device, 4, 6);
+  occa::ndarray<int, 2> view = matrix.slice(1, 2, 3).transpose();
+
+  occa::ndarray<float, 2> halves = view.map(OCCA_FUNCTION([](const int &value) -> float {
+    return value / 2.0;
+  }));
+  ASSERT_EQ(3, (int) halves.shape(0));
+  ASSERT_EQ(4, (int) halves.shape(1));
+  ASSERT_TRUE(halves.isRowMajor());
+
+  float halfValues[12];
+  halves.copyTo(halfValues);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_EQ((float) ((j * 6 + i + 2) / 2.0), halfValues[i * 4 + j]);
+    }
+  }
+
+  // The index is the row-major index of the view
+  occa::ndarray<int, 2> indices = view.map(OCCA_FUNCTION([](const int &value, const int index) -> int {
+    return index;
+  }));
+  int indexValues[12];
+  indices.copyTo(indexValues);
+  for (int i = 0; i < 12; ++i) {
+    ASSERT_EQ(i, indexValues[i]);
+  }
+
+  // Map in-place on a view
+  occa::ndarray<int, 2> column = matrix.slice(1, 4, 1);
+  column.mapTo(column, OCCA_FUNCTION([](const int &value) -> int {
+    return -value;
+  }));
+
+  int matrixValues[24];
+  matrix.copyTo(matrixValues);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      const int value = i * 6 + j;
+      ASSERT_EQ(j == 4 ? -value : value, matrixValues[i * 6 + j]);
+    }
+  }
+}
+
+void testFill(occa::device device) {
+  occa::ndarray<int, 2> matrix = getIndexMatrix(device, 4, 6);
+  matrix.slice(0, 0, -1, 2).slice(1, 1, 2).fill(-1);
+
+  int matrixValues[24];
+  matrix.copyTo(matrixValues);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      const bool isFilled = ((i % 2) == 0) && (j == 1 || j == 2);
+      ASSERT_EQ(isFilled ? -1 : (i * 6 + j), matrixValues[i * 6 + j]);
+    }
+  }
+}
+
+void testReduce(occa::device device) {
+  occa::ndarray<int, 2> matrix = getIndexMatrix(device, 4, 6);
+
+  ASSERT_EQ(23, matrix.max());
+  ASSERT_EQ(0, matrix.min());
+
+  // Contiguous view
+  occa::ndarray<int, 2> rows = matrix.slice(0, 1, 2);
+  ASSERT_TRUE(rows.isContiguous());
+  ASSERT_EQ(17, rows.max());
+  ASSERT_EQ(6, rows.min());
+
+  // View with gaps
+  occa::ndarray<int, 2> block = matrix.slice(0, 1, 2).slice(1, 2, 3);
+  ASSERT_FALSE(block.isContiguous());
+  ASSERT_EQ(16, block.max());
+  ASSERT_EQ(8, block.min());
+
+  const int sum = block.reduce<int>(
+    occa::reductionType::sum,
+    OCCA_FUNCTION([](const int &acc, const int &value) -> int {
+      return acc + value;
+    })
+  );
+  ASSERT_EQ(8 + 9 + 10 + 14 + 15 + 16, sum);
+}
+
+void testHighDimensions(occa::device device) {
+  const int shape[4] = {2, 3, 4, 5};
+  const int size = 2 * 3 * 4 * 5;
+
+  std::vector<int> values(size);
+  for (int i = 0; i < size; ++i) {
+    values[i] = i;
+  }
+
+  occa::ndarray<int, 4> tensor(device, {shape[0], shape[1], shape[2], shape[3]});
+  tensor.copyFrom(values.data());
+
+  // Swap the outermost and innermost dimensions
+  occa::ndarray<int, 4> transposed = tensor.transpose(0, 3).clone();
+  ASSERT_EQ(5, (int) transposed.shape(0));
+  ASSERT_EQ(2, (int) transposed.shape(3));
+
+  std::vector<int> transposedValues(size);
+  transposed.copyTo(transposedValues.data());
+  for (int i0 = 0; i0 < shape[0]; ++i0) {
+    for (int i1 = 0; i1 < shape[1]; ++i1) {
+      for (int i2 = 0; i2 < shape[2]; ++i2) {
+        for (int i3 = 0; i3 < shape[3]; ++i3) {
+          const int index = ((i0 * shape[1] + i1) * shape[2] + i2) * shape[3] + i3;
+          const int transposedIndex = ((i3 * shape[1] + i1) * shape[2] + i2) * shape[0] + i0;
+          ASSERT_EQ(index, transposedValues[transposedIndex]);
+        }
+      }
+    }
+  }
+
+  occa::ndarray<int, 4> indices = tensor.slice(2, 1, 2).map(
+    OCCA_FUNCTION([](const int &value, const int index) -> int {
+      return index;
+    })
+  );
+  ASSERT_EQ(2 * 3 * 2 * 5, (int) indices.size());
+  ASSERT_EQ(2 * 3 * 2 * 5 - 1, indices.max());
+}
+
+void testDimAttributes(occa::device device) {
+  occa::ndarray<int, 2> matrix = getIndexMatrix(
+    device, 3, 5, occa::ndarrayLayout::rowMajor, 4
+  );
+  ASSERT_EQ("@dim(3, 8) @dimOrder(1, 0)",
+            matrix.dimAttributes());
+  ASSERT_EQ("@dim(8, 3) @dimOrder(0, 1)",
+            matrix.transpose().dimAttributes());
+  ASSERT_EQ("@dim(3, 8) @dimOrder(1, 0)",
+            matrix.slice(1, 1, 3).dimAttributes());
+
+  ASSERT_THROW(
+    matrix.slice(1, 0, -1, 2).dimAttributes();
+  );
+
+  // Index a padded transposed view as (i, j) in a kernel
+  occa::ndarray<int, 2> view = matrix.slice(1, 1, 3).transpose();
+
+  occa::kernel sumRows = device.buildKernelFromString(
+    "@kernel void sumRows(const int rows,"
+    "                     const int columns,"
+    "                     const int *values " + view.dimAttributes() + ","
+    "                     int *sums) {"
+    "  for (int i = 0; i < rows; ++i; @tile(16, @outer, @inner)) {"
+    "    int sum = 0;"
+    "    for (int j = 0; j < columns; ++j) {"
+    "      sum += values(i, j);"
+    "    }"
+    "    sums[i] = sum;"
+    "  }"
+    "}",
+    "sumRows"
+  );
+
+  occa::array<int> sums(device, 3);
+  sumRows((int) view.shape(0), (int) view.shape(1), view, sums.memory());
+
+  for (int i = 0; i < 3; ++i) {
+    // Column (i + 1) of the matrix
+    const int column = i + 1;
+    ASSERT_EQ(column + (5 + column) + (10 + column), sums[i]);
+  }
+}
@@ -70,7 +70,7 @@ int main(const int argc, const char **argv) {
 
   occa::io::stdout.setOverride(saveOutput);
 
-  const std::string commands = "autocomplete clear compile env info modes translate version";
+  const std::string commands = "autocomplete clear compile compile-server env info modes translate version";
   const std::string helpOptions = "--help -h";
 
   const std::string modeSuggetions = getModes();
@@ -201,6 +201,12 @@ int main(const int argc, const char **argv) {
     compileOptions
   );
 
+  //---[ Compile Server ]-----------
+  ASSERT_AUTOCOMPLETE_EQ(
+    "occa compile-server -",
+    "--help --jobs --socket --stats --stop -h -j -s"
+  );
+
   //---[ Translate ]------------------
   const std::string translateOptions = (
     "--define --help --include-path --kernel-props --launcher --mode --verbose -D -I -h -k -l -m -v"
@@ -0,0 +1,152 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <occa.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testLock();
+void testStaleLocks();
+void testTimeout();
+void testStaleLockRace();
+
+int main(const int argc, const char **argv) {
+  testLock();
+  testStaleLocks();
+  testTimeout();
+  testStaleLockRace();
+
+  return 0;
+}
+
+void testLock() {
+  const occa::hash_t hash = occa::hash_t::random();
+
+  occa::io::lock_t lock1(hash, "test");
+  occa::io::lock_t lock2(hash, "test");
+  occa::io::lock_t otherLock(hash, "other");
+
+  ASSERT_TRUE(lock1.tryAcquire());
+  ASSERT_TRUE(lock1.isMine());
+  ASSERT_TRUE(occa::io::isDir(lock1.dir()));
+
+  ASSERT_FALSE(lock2.tryAcquire());
+  ASSERT_TRUE(otherLock.tryAcquire());
+
+  // Blocking acquires wait for the release
+  bool acquired = false;
+  std::thread waiter([&]() {
+    lock2.acquire();
+    acquired = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(acquired);
+
+  lock1.release();
+  waiter.join();
+  ASSERT_TRUE(acquired);
+  ASSERT_TRUE(lock2.isMine());
+  ASSERT_FALSE(lock1.isMine());
+
+  lock2.release();
+  otherLock.release();
+  ASSERT_FALSE(occa::io::isDir(lock1.dir()));
+}
+
+void testStaleLocks() {
+  occa::settings()["locks/stale_age"] = 0.5;
+
+  const occa::hash_t hash = occa::hash_t::random();
+  occa::io::lock_t lock1(hash, "test");
+  occa::io::lock_t lock2(hash, "test");
+
+  // Locks held by live processes on the same host are never stale
+  ASSERT_TRUE(lock1.tryAcquire());
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  ASSERT_FALSE(lock1.isStale());
+  ASSERT_FALSE(lock2.tryAcquire());
+  lock1.release();
+
+  // Owners on other hosts are only checked by age
+  occa::sys::mkpath(lock1.dir());
+  occa::io::write(lock1.dir() + "/owner", "other-host 1");
+  ASSERT_FALSE(lock2.tryAcquire());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  ASSERT_TRUE(lock2.isStale());
+  ASSERT_TRUE(lock2.tryAcquire());
+  lock2.release();
+
+  occa::settings()["locks/stale_age"] = 20.0;
+}
+
+void testTimeout() {
+  occa::settings()["locks/timeout"] = 0.5;
+
+  const occa::hash_t hash = occa::hash_t::random();
+  occa::io::lock_t lock1(hash, "test");
+  occa::io::lock_t lock2(hash, "test");
+
+  // Waiting on a live owner errors out instead of hanging
+  ASSERT_TRUE(lock1.tryAcquire());
+  ASSERT_THROW(lock2.acquire());
+  ASSERT_FALSE(lock2.isMine());
+  lock1.release();
+
+  lock2.acquire();
+  ASSERT_TRUE(lock2.isMine());
+  lock2.release();
+
+  occa::settings()["locks/timeout"] = 600.0;
+}
+
+void testStaleLockRace() {
+  char hostname[256] = {0};
+  ::gethostname(hostname, sizeof(hostname) - 1);
+
+  const occa::hash_t hash = occa::hash_t::random();
+  const int threadCount = 8;
+
+  for (int round = 0; round < 20; ++round) {
+    // Locks from dead processes on this host are stale right away
+    occa::io::lock_t staleLock(hash, "test");
+    occa::sys::mkpath(staleLock.dir());
+    occa::io::write(staleLock.dir() + "/owner", std::string(hostname) + " 999999999");
+
+    // Waiters racing to remove the stale lock never remove a live one
+    std::atomic<int> holders(0);
+    std::atomic<int> maxHolders(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i) {
+      threads.push_back(std::thread([&]() {
+        occa::io::lock_t lock(hash, "test");
+        if (!lock.tryAcquire()) {
+          return;
+        }
+        const int currentHolders = ++holders;
+        int previousMax = maxHolders;
+        while ((previousMax < currentHolders)
+               && !maxHolders.compare_exchange_weak(previousMax, currentHolders)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --holders;
+        lock.release();
+      }));
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(1, (int) maxHolders);
+    ASSERT_FALSE(occa::io::isDir(staleLock.dir()));
+  }
+
+  // Stale locks moved aside are removed
+  for (const std::string &dir : occa::io::directories(occa::env::OCCA_CACHE_DIR + "locks/")) {
+    ASSERT_EQ(std::string::npos, dir.find(hash.getString()));
+  }
+}
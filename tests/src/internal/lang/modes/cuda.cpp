@@ -27,6 +27,7 @@ void testKernelArgs();
 void testSharedAnnotation();
 void testBarriers();
 void testAtomic();
+void testReduction();
 void testSource();
 
 int main(const int argc, const char **argv) {
@@ -37,6 +38,7 @@ int main(const int argc, const char **argv) {
   testKernelArgs();
   testSharedAnnotation();
   testBarriers();
+  testReduction();
   testSource();
 
   return 0;
@@ -78,6 +80,36 @@ void testAtomic() {
 }
 //======================================
 
+//---[ @reduction ]---------------------
+void testReduction() {
+  // Only OpenMP lowers @reduction, other backends parse and drop it
+  parseSource(
+    "@kernel void foo(float *a, float *result, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer @reduction(\"+\", total)) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {\n"
+    "      total += a[i];\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_TRUE(parser.success);
+
+  printer pout;
+  parser.root.print(pout);
+  ASSERT_EQ(std::string::npos, pout.str().find("reduction"));
+
+  parseBadSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer @reduction(\"-\", total)) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+}
+//======================================
+
 //---[ Barriers ]-----------------------
 void testBarriers() {
   // Add barriers barrier(CLK_LOCAL_MEM_FENCE)
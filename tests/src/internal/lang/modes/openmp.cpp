@@ -4,14 +4,24 @@
 #include "../parserUtils.hpp"
 
 void testPragma();
+void testCollapse();
+void testLoopClauses();
 void testAtomic();
+void testReduction();
+void testSimd();
+void testGraphKernel();
 
 int main(const int argc, const char **argv) {
   parser.settings["okl/validate"] = false;
   parser.settings["serial/include_std"] = false;
 
   testPragma();
+  testCollapse();
+  testLoopClauses();
   testAtomic();
+  testReduction();
+  testSimd();
+  testGraphKernel();
 
   return 0;
 }
@@ -31,6 +41,22 @@ int main(const int argc, const char **argv) {
               ompPragma.value());                                       \
   } while(0)
 
+#define ASSERT_PRAGMAS(...)                                     \
+  do {                                                          \
+    occa::strVector expectedPragmas = {__VA_ARGS__};            \
+    statementArray pragmaStatements = (                         \
+      parser.root.children                                      \
+      .flatFilterByStatementType(statementType::pragma)         \
+    );                                                          \
+                                                                \
+    ASSERT_EQ((int) expectedPragmas.size(),                     \
+              (int) pragmaStatements.length());                 \
+    for (int i = 0; i < (int) expectedPragmas.size(); ++i) {    \
+      ASSERT_EQ(expectedPragmas[i],                             \
+                pragmaStatements[i]->to<pragmaStatement>().value()); \
+    }                                                           \
+  } while(0)
+
 //---[ Pragma ]-------------------------
 void testPragma() {
   // @outer -> #pragma omp
@@ -41,6 +67,109 @@ void testPragma() {
   );
   ASSERT_PRAGMA_EXISTS("omp parallel for", 1);
 }
+
+void testCollapse() {
+  // Perfectly nested @outer loops are collapsed
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int k = 0; k < 4; ++k; @outer(2)) {\n"
+    "    for (int j = 0; j < N; ++j; @outer(1)) {\n"
+    "      for (int i = 0; i < N; ++i; @outer(0)) {\n"
+    "        for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for collapse(3)", "omp simd");
+
+  // Statements between the loops stop collapsing
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int j = 0; j < N; ++j; @outer(1)) {\n"
+    "    const int offset = j * N;\n"
+    "    for (int i = 0; i < N; ++i; @outer(0)) {\n"
+    "      for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+
+  // Triangular loops can't be collapsed
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int j = 0; j < N; ++j; @outer(1)) {\n"
+    "    for (int i = 0; i < j; ++i; @outer(0)) {\n"
+    "      for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+
+  parser.settings["openmp/collapse"] = false;
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int j = 0; j < N; ++j; @outer(1)) {\n"
+    "    for (int i = 0; i < N; ++i; @outer(0)) {\n"
+    "      for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+  parser.settings["openmp/collapse"] = true;
+}
+
+void testLoopClauses() {
+  const std::string loopSource = (
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int i = 0; i < N; ++i; @outer) {\n"
+    "    for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+
+  parser.settings["openmp/schedule"] = "dynamic";
+  parser.settings["openmp/chunk"] = 4;
+  parser.settings["openmp/num_threads"] = 8;
+  parser.settings["openmp/proc_bind"] = "spread";
+  parseSource(loopSource);
+  ASSERT_PRAGMAS("omp parallel for schedule(dynamic, 4) num_threads(8) proc_bind(spread)",
+                 "omp simd");
+
+  // A chunk without a schedule uses static scheduling
+  parser.settings.remove("openmp");
+  parser.settings["openmp/chunk"] = 2;
+  parseSource(loopSource);
+  ASSERT_PRAGMAS("omp parallel for schedule(static, 2)", "omp simd");
+  parser.settings.remove("openmp");
+
+  // Loop hints override the kernel properties
+  parser.settings["openmp/schedule"] = "static";
+  parseSource(
+    "@kernel void foo(float *a, int N, int nt) {\n"
+    "  for (int i = 0; i < N; ++i; @outer(schedule=\"guided\", num_threads=nt)) {\n"
+    "    for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for schedule(guided) num_threads(nt)", "omp simd");
+  parser.settings.remove("openmp");
+
+  parser.settings["openmp/schedule"] = "fastest";
+  parseBadSource(loopSource);
+  parser.settings.remove("openmp");
+
+  parseBadSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int i = 0; i < N; ++i; @outer(unroll=4)) {\n"
+    "    for (int t = 0; t < 16; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+}
 //======================================
 
 //---[ @atomic ]------------------------
@@ -71,6 +200,305 @@ void testAtomic() {
     "  i += 1;\n"
     "}\n"
   );
-  ASSERT_PRAGMA_EXISTS("omp critical", 1);
+  ASSERT_PRAGMA_EXISTS("omp critical(_occa_atomic_i)", 1);
+
+  parseSource(
+    "int i;\n"
+    "@atomic i *= 2;\n"
+  );
+  ASSERT_PRAGMA_EXISTS("omp atomic", 1);
+
+  // Min/max updates use a compare-and-swap loop
+  parseSource(
+    "float x, y;\n"
+    "@atomic x = max(x, 2 * y);\n"
+    "@atomic {\n"
+    "  x = fmin(y, x);\n"
+    "}\n"
+  );
+  ASSERT_PRAGMAS();
+  ASSERT_EQ(
+    "occa::atomicMax(&(x), 2 * y);",
+    parser.root.children
+    .flatFilterByStatementType(statementType::sourceCode)[0]
+    ->to<sourceCodeStatement>().sourceCode
+  );
+
+  // Blocks touching the same variables share a critical section
+  parseSource(
+    "@kernel void foo(@restrict float *a, @restrict float *b, @restrict float *c) {\n"
+    "  @atomic { a[0] += 1; b[0] += a[0]; }\n"
+    "  @atomic { b[1] += 1; b[2] += 1; }\n"
+    "  @atomic { c[0] += 1; c[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical(_occa_atomic_a)",
+                 "omp critical(_occa_atomic_a)",
+                 "omp critical(_occa_atomic_c)");
+
+  // Groups linked by a later block are merged
+  parseSource(
+    "@kernel void foo(@restrict int *a, @restrict int *b, @restrict int *x,\n"
+    "                 @restrict int *y, @restrict int *z) {\n"
+    "  @atomic { a[0] += 1; y[0] += 1; }\n"
+    "  @atomic { b[0] += 1; z[0] += 1; }\n"
+    "  @atomic { x[0] += 1; y[0] += 2; z[0] += 2; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical(_occa_atomic_a)",
+                 "omp critical(_occa_atomic_a)",
+                 "omp critical(_occa_atomic_a)");
+
+  // Local arrays and scalars can't alias other targets
+  parseSource(
+    "@kernel void foo(@restrict float *a) {\n"
+    "  float counts[2];\n"
+    "  int total;\n"
+    "  @atomic { counts[0] += 1; counts[1] += 1; }\n"
+    "  @atomic { total += 1; total += 1; }\n"
+    "  @atomic { a[0] += 1; a[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical(_occa_atomic_counts)",
+                 "omp critical(_occa_atomic_total)",
+                 "omp critical(_occa_atomic_a)");
+
+  // Unknown writes fall back to the global critical section
+  parseSource(
+    "@kernel void foo(@restrict float *a, @restrict float *c) {\n"
+    "  @atomic { *a += 1; a[1] += 1; }\n"
+    "  @atomic { c[0] += 1; c[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical", "omp critical");
+
+  // Arguments without @restrict can point to the same memory
+  parseSource(
+    "@kernel void foo(float *a, float *b) {\n"
+    "  @atomic { a[0] += 1; a[1] += 1; }\n"
+    "  @atomic { b[0] += 1; b[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical", "omp critical");
+
+  parseSource(
+    "@kernel void foo(float a[], @restrict float *b) {\n"
+    "  @atomic { a[0] += 1; a[1] += 1; }\n"
+    "  @atomic { b[0] += 1; b[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical", "omp critical");
+
+  // Local pointers can alias arguments
+  parseSource(
+    "@kernel void foo(@restrict float *a) {\n"
+    "  float *p = a;\n"
+    "  @atomic { a[0] += 1; a[1] += 1; }\n"
+    "  @atomic { p[0] += 1; p[1] += 1; }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp critical", "omp critical");
+}
+//======================================
+
+//---[ @reduction ]---------------------
+void testReduction() {
+  parseSource(
+    "@kernel void foo(float *a, float *result, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer @reduction(\"+\", total)) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {\n"
+    "      total += a[i];\n"
+    "    }\n"
+    "  }\n"
+    "  result[0] = total;\n"
+    "}"
+  );
+  // Updating [total] in the @inner loop is a loop-carried dependence
+  ASSERT_PRAGMAS("omp parallel for reduction(+:total)");
+
+  parseBadSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer @reduction(\"-\", total)) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+
+  parseBadSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int j = 0; j < N; ++j; @outer) {\n"
+    "    for (int i = 0; i < N; ++i; @outer @reduction(\"+\", total)) {\n"
+    "      for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+}
+//======================================
+
+//---[ SIMD ]---------------------------
+void testSimd() {
+  // Only the inner-most @inner loop is vectorized
+  parseSource(
+    "@kernel void foo(float *a) {\n"
+    "  for (int o = 0; o < 10; ++o; @outer) {\n"
+    "    for (int j = 0; j < 4; ++j; @inner) {\n"
+    "      for (int i = 0; i < 16; ++i; @inner) {\n"
+    "        a[i] = i;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+
+  // Loops that can't run out of order are skipped
+  parseSource(
+    "@kernel void foo(float *a) {\n"
+    "  for (int o = 0; o < 10; ++o; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      if (i > 4) return;\n"
+    "      a[i] = i;\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      @atomic a[0] += i;\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp atomic");
+
+  // Writing variables declared outside of the loop carries a dependence
+  parseSource(
+    "@kernel void foo(float *a) {\n"
+    "  for (int o = 0; o < 10; ++o; @outer) {\n"
+    "    float last = 0;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      last = a[i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      float value = a[i];\n"
+    "      value *= 2;\n"
+    "      a[i] = value + last;\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+
+  // The exclusive index advances linearly
+  parseSource(
+    "@kernel void foo(float *a) {\n"
+    "  for (int o = 0; o < 10; ++o; @outer) {\n"
+    "    @exclusive float x;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x = a[i];\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd linear(_occa_exclusive_index:1)");
+
+  parser.settings["okl/simd"] = false;
+  parseSource(
+    "@kernel void foo(float *a) {\n"
+    "  for (int o = 0; o < 10; ++o; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      a[i] = i;\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for");
+  parser.settings["okl/simd"] = true;
+}
+//======================================
+
+//---[ Graph ]--------------------------
+std::string getGraphKernelSource() {
+  statementArray sourceStatements = (
+    parser.root.children
+    .flatFilterByStatementType(statementType::sourceCode)
+  );
+  for (statement_t *smnt : sourceStatements) {
+    const std::string &sourceCode = smnt->to<sourceCodeStatement>().sourceCode;
+    if (occa::contains(sourceCode, "_occa_graph_launch")) {
+      return sourceCode;
+    }
+  }
+  return "";
+}
+
+void testGraphKernel() {
+  std::string graphSource;
+
+  // Graph variants share the parallel region of the graph launch
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  const int M = N / 2;\n"
+    "  for (int i = 0; i < M; ++i; @outer) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {\n"
+    "      a[i] = i;\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMAS("omp parallel for", "omp simd");
+
+  graphSource = getGraphKernelSource();
+  ASSERT_TRUE(occa::contains(graphSource, "foo_occa_graph("));
+  ASSERT_TRUE(occa::contains(graphSource, "#pragma omp for\n"));
+  ASSERT_FALSE(occa::contains(graphSource, "omp parallel"));
+  ASSERT_TRUE(occa::contains(graphSource, "void foo_occa_graph_launch(void **args)"));
+
+  // Statements outside of @outer loops would run on every thread
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  a[0] = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_EQ("", getGraphKernelSource());
+
+  // Reductions and thread counts need their own parallel region
+  parseSource(
+    "@kernel void foo(float *a, float *result, int N) {\n"
+    "  float total = 0;\n"
+    "  for (int i = 0; i < N; ++i; @outer @reduction(\"+\", total)) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {\n"
+    "      total += a[i];\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_EQ("", getGraphKernelSource());
+
+  parser.settings["openmp/num_threads"] = 4;
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int i = 0; i < N; ++i; @outer) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_EQ("", getGraphKernelSource());
+  parser.settings.remove("openmp");
+
+  // Scheduling clauses are kept on the shared loops
+  parser.settings["openmp/schedule"] = "dynamic";
+  parseSource(
+    "@kernel void foo(float *a, int N) {\n"
+    "  for (int i = 0; i < N; ++i; @outer) {\n"
+    "    for (int t = 0; t < 1; ++t; @inner) {}\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_TRUE(occa::contains(getGraphKernelSource(), "#pragma omp for schedule(dynamic)\n"));
+  parser.settings.remove("openmp");
 }
 //======================================
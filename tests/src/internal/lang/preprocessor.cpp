@@ -6,6 +6,7 @@
 #include <occa/internal/lang/tokenizer.hpp>
 #include <occa/internal/lang/processingStages.hpp>
 #include <occa/internal/lang/preprocessor.hpp>
+#include <occa/internal/lang/tokenCache.hpp>
 
 void testMacroDefines();
 void testCppStandardTests();
@@ -654,12 +655,18 @@ void testInclude() {
      << "#include \"" << testFile << "\"\n";
   setStream(ss.str());
 
+  // The second include reads tokens from the token cache
   for (int i = 0; i < 2; ++i) {
     for (int j = 0; j < 5; ++j) {
       ASSERT_EQ(j,
                 (int) nextTokenPrimitiveValue());
+      ASSERT_EQ(2,
+                token->origin.position.line);
+      ASSERT_EQ(testFile,
+                token->origin.file->filename);
     }
   }
+  ASSERT_TRUE(tokenCache::get(occa::hash(occa::io::read(testFile))) != NULL);
   // Error out in the last include
   while(!tokenStream.isEmpty()) {
     getToken();
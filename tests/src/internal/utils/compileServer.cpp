@@ -0,0 +1,210 @@
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <occa.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/compileServer.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+void testCompile(const std::string &socketPath);
+void testKernelBuild(const std::string &socketPath);
+void testRequestHandling(const std::string &socketPath);
+
+int main(const int argc, const char **argv) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+  // Unix socket paths are limited to ~100 characters
+  const std::string socketPath = (
+    "/tmp/occa_compile_server_" + occa::toString(occa::sys::getPID()) + ".sock"
+  );
+
+  int exitCode;
+  std::string output;
+  ASSERT_FALSE(occa::compileServer::compile(socketPath, "binary", "true", exitCode, output));
+
+  std::thread server([&]() {
+    occa::compileServer::serve(socketPath, 2);
+  });
+
+  occa::json stats;
+  while (!occa::compileServer::getStats(socketPath, stats)) {
+    std::this_thread::yield();
+  }
+
+  testCompile(socketPath);
+  testKernelBuild(socketPath);
+  testRequestHandling(socketPath);
+
+  ASSERT_TRUE(occa::compileServer::stop(socketPath));
+  server.join();
+  ASSERT_FALSE(occa::io::exists(socketPath));
+#endif
+
+  return 0;
+}
+
+void testCompile(const std::string &socketPath) {
+  const std::string dir = occa::io::cachePath() + occa::hash_t::random().getString() + "/";
+  const std::string binaryFilename = dir + "binary";
+  const std::string runsFilename = dir + "runs";
+  occa::sys::mkpath(dir);
+
+  const std::string command = (
+    "echo run >> " + runsFilename
+    + " && sleep 1"
+    + " && echo built > " + occa::compileServer::outputPlaceholder
+  );
+
+  // Concurrent requests for the same binary only run the command once
+  const int requests = 4;
+  std::vector<int> exitCodes(requests, -1);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < requests; ++i) {
+    threads.push_back(std::thread([&, i]() {
+      std::string output;
+      ASSERT_TRUE(occa::compileServer::compile(socketPath,
+                                               binaryFilename,
+                                               command,
+                                               exitCodes[i],
+                                               output));
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < requests; ++i) {
+    ASSERT_EQ(exitCodes[i], 0);
+  }
+  ASSERT_EQ(occa::io::read(binaryFilename), "built\n");
+  ASSERT_EQ(occa::io::read(runsFilename), "run\n");
+
+  occa::json stats;
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+  ASSERT_GE((int) stats["compiled"], 1);
+  ASSERT_EQ((int) stats["compiled"] + (int) stats["deduplicated"], requests);
+  ASSERT_EQ((int) stats["pending"], 0);
+
+  // Failures are sent back with the command output
+  int exitCode;
+  std::string output;
+  ASSERT_TRUE(occa::compileServer::compile(socketPath,
+                                           dir + "failed_binary",
+                                           "echo compile-error && false",
+                                           exitCode,
+                                           output));
+  ASSERT_NEQ(exitCode, 0);
+  ASSERT_NEQ(output.find("compile-error"), std::string::npos);
+  ASSERT_FALSE(occa::io::exists(dir + "failed_binary"));
+
+  occa::sys::rmrf(dir);
+}
+
+void testKernelBuild(const std::string &socketPath) {
+  occa::json stats;
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+  const int compiled = stats["compiled"];
+
+  occa::device device({
+    {"mode", "Serial"},
+    {"kernel", {
+      {"compile_server", socketPath}
+    }}
+  });
+
+  occa::kernel addVectors = device.buildKernel(
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl",
+    "addVectors",
+    {{"defines/COMPILE_SERVER_ID", "id_" + occa::hash_t::random().getString()}}
+  );
+
+  const int entries = 5;
+  float ab[entries] = {0, 1, 2, 3, 4};
+  occa::memory o_a = device.malloc<float>(entries, ab);
+  occa::memory o_b = device.malloc<float>(entries, ab);
+  occa::memory o_ab = device.malloc<float>(entries);
+
+  addVectors(entries, o_a, o_b, o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(ab[entries - 1], 8.0f);
+
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+  ASSERT_EQ((int) stats["compiled"], compiled + 1);
+}
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+int connectToServer(const std::string &socketPath) {
+  sockaddr_un address;
+  ::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  ::strcpy(address.sun_path, socketPath.c_str());
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(::connect(fd, (sockaddr*) &address, sizeof(address)), 0);
+  return fd;
+}
+
+std::string readResponse(const int fd) {
+  std::string response;
+  char buffer[1024];
+  ssize_t bytes;
+  while ((bytes = ::read(fd, buffer, sizeof(buffer))) > 0) {
+    response.append(buffer, bytes);
+  }
+  return response;
+}
+#endif
+
+void testRequestHandling(const std::string &socketPath) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+  // Only the server's user can connect
+  struct stat socketStat;
+  ASSERT_EQ(::stat(socketPath.c_str(), &socketStat), 0);
+  ASSERT_EQ((int) (socketStat.st_mode & 0777), 0600);
+
+  // A client that hasn't finished sending its request doesn't block others
+  const int slowFd = connectToServer(socketPath);
+  const std::string partialRequest = "{\"type\": ";
+  ASSERT_EQ((size_t) ::write(slowFd, partialRequest.c_str(), partialRequest.size()),
+            partialRequest.size());
+
+  occa::json stats;
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+
+  // Malformed requests get an error response and the server keeps running
+  ::shutdown(slowFd, SHUT_WR);
+  const occa::json response = occa::json::parse(readResponse(slowFd));
+  ::close(slowFd);
+  ASSERT_TRUE(response.has("error"));
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+
+  // Binaries are only written inside the cache
+  const std::string binaryFilename = (
+    "/tmp/occa_compile_server_binary_" + occa::hash_t::random().getString()
+  );
+  int exitCode;
+  std::string output;
+  ASSERT_FALSE(occa::compileServer::compile(socketPath,
+                                            binaryFilename,
+                                            "echo built > " + occa::compileServer::outputPlaceholder,
+                                            exitCode,
+                                            output));
+  ASSERT_FALSE(occa::io::exists(binaryFilename));
+  ASSERT_FALSE(occa::compileServer::compile(socketPath,
+                                            occa::io::cachePath() + "../binary",
+                                            "echo built > " + occa::compileServer::outputPlaceholder,
+                                            exitCode,
+                                            output));
+  ASSERT_TRUE(occa::compileServer::getStats(socketPath, stats));
+#endif
+}